@@ -0,0 +1,88 @@
+// Storage for the live window's per-cell buffers (grid, moved, the reactions' scratch).
+// The step addresses them as rows of SW bytes from the interior column X0, so each
+// buffer is placed with byte X0 on a cache line: with SW a multiple of 64 (gridStride())
+// every chunk column of every row then starts a line, and the W-byte blocks of a
+// vertical sub-pass never split one (see simdStep()). On Linux the buffer is its own
+// mapping with transparent huge pages requested, so a large window's rows are not
+// spread over thousands of 4 KiB TLB entries. The kernel may still decline; the
+// layout and the result are the same either way.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+static constexpr size_t GRID_ALIGN = 64;                  // a cache line, and AVX-512's W
+static constexpr size_t HUGE_PAGE = (size_t)2 << 20;
+
+// The padded row stride for a window `cells` wide with `pad` border columns each side:
+// rounded up to GRID_ALIGN, the spare columns joining the right border.
+constexpr int gridStride(int cells, int pad) {
+    return (int)(((size_t)cells + 2 * pad + GRID_ALIGN - 1) / GRID_ALIGN * GRID_ALIGN);
+}
+
+class GridBuffer {
+public:
+    GridBuffer() = default;
+    GridBuffer(const GridBuffer&) = delete;
+    GridBuffer& operator=(const GridBuffer&) = delete;
+    ~GridBuffer() { release(); }
+
+    // n bytes of v, byte `origin` GRID_ALIGN-aligned. Drops the previous contents.
+    void assign(size_t n, uint8_t v, size_t origin = 0) {
+        release();
+        const size_t lead = (GRID_ALIGN - origin % GRID_ALIGN) % GRID_ALIGN;
+        bytes = lead + n;
+#if defined(__linux__)
+        // A buffer of a huge page or more is whole huge pages from a huge-page boundary
+        // (over-map by one, trim the ends); a smaller one would only waste the page.
+        const size_t page = bytes >= HUGE_PAGE ? HUGE_PAGE : 4096;
+        const size_t len = (bytes + page - 1) / page * page, extra = page == HUGE_PAGE ? page : 0;
+        void* m = mmap(nullptr, len + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (m == MAP_FAILED) throw std::bad_alloc();
+        uint8_t* b = (uint8_t*)m;
+        uint8_t* a = (uint8_t*)(((uintptr_t)b + page - 1) & ~(uintptr_t)(page - 1));
+        if (a > b) munmap(b, (size_t)(a - b));
+        if (b + len + extra > a + len) munmap(a + len, (size_t)(b + len + extra - (a + len)));
+        if (extra) madvise(a, len, MADV_HUGEPAGE);
+        base = a;
+        mapped = len;
+#else
+        base = (uint8_t*)::operator new(bytes, std::align_val_t(GRID_ALIGN));
+#endif
+        p = base + lead;
+        count = n;
+        std::memset(p, v, n);
+    }
+
+    void swap(GridBuffer& o) {
+        std::swap(base, o.base); std::swap(p, o.p);
+        std::swap(bytes, o.bytes); std::swap(mapped, o.mapped); std::swap(count, o.count);
+    }
+
+    uint8_t* data() { return p; }
+    const uint8_t* data() const { return p; }
+    size_t size() const { return count; }
+    uint8_t& operator[](size_t i) { return p[i]; }
+    const uint8_t& operator[](size_t i) const { return p[i]; }
+
+private:
+    void release() {
+        if (!base) return;
+#if defined(__linux__)
+        munmap(base, mapped);
+#else
+        ::operator delete(base, std::align_val_t(GRID_ALIGN));
+#endif
+        base = p = nullptr;
+        bytes = mapped = count = 0;
+    }
+
+    uint8_t* base = nullptr;   // the allocation
+    uint8_t* p = nullptr;      // byte 0 of the buffer
+    size_t bytes = 0, mapped = 0, count = 0;
+};
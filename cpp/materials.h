@@ -2,6 +2,7 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
+#include <initializer_list>
 
 // Density order (heavy -> light): SAND > LAVA > WATER > OIL > air > GAS > FIRE,
 // with STEAM the lightest (rises). OIL floats on water; FIRE rises and burns out;
@@ -116,6 +117,20 @@ enum Material : uint8_t {
     MATERIAL_COUNT = 70
 };
 
+// A set of material ids, one bit per id, so rule tables can name their materials as
+// a list ({FIRE, LAVA}) and the host can keep per-region presence cheaply.
+struct MatMask {
+    uint64_t w[2];
+    constexpr MatMask() : w{0, 0} {}
+    constexpr MatMask(std::initializer_list<int> ms) : w{0, 0} { for (int m : ms) add(m); }
+    constexpr void add(int m) { w[m >> 6] |= 1ull << (m & 63); }
+    constexpr bool has(int m) const { return (w[m >> 6] >> (m & 63)) & 1u; }
+    constexpr bool empty() const { return (w[0] | w[1]) == 0; }
+    constexpr bool meets(const MatMask& o) const { return ((w[0] & o.w[0]) | (w[1] & o.w[1])) != 0; }
+    constexpr MatMask& operator|=(const MatMask& o) { w[0] |= o.w[0]; w[1] |= o.w[1]; return *this; }
+};
+static_assert(MATERIAL_COUNT <= 128, "MatMask holds 128 material ids");
+
 // Fire burn-out: a per-cell, time-varying transform that is a PURE function of
 // (x, y, frame) -- no neighbour reads -- so it stays order-independent and is
 // bit-identical on CPU SIMD and the GPU compute backends (which compute the same
@@ -229,17 +244,23 @@ inline void decayFire(uint8_t* grid, int SW, int X0, int X1, int Y0, int Y1, uin
 
 // Ignition: OIL touching FIRE (4-neighbour) catches and becomes FIRE, so flame
 // spreads through fuel one layer per frame. Done in two per-cell passes through a
-// scratch buffer (the `moved` flags, free after the movement step): pass 1 reads
+// byte-per-cell scratch buffer (GPU: the `moved` flags, free after the movement step;
+// CPU: its own mark buffer, since movement keeps `moved` bit-packed): pass 1 reads
 // a consistent snapshot of the grid and records intent; pass 2 applies it. Each
 // pass reads one buffer and writes another, so it is order-independent and the
 // GPU reproduces it bit-for-bit.
+//
+// Every two-pass reaction takes the passes to run. Pass 2 reads only its own grid
+// cell (and scratch within reach), so a banded multi-threaded frame runs MARK_PASS
+// over every band, then APPLY_PASS, with a barrier between -- the GPU's two dispatches.
+enum ReactPass { MARK_PASS = 1, APPLY_PASS = 2, BOTH_PASSES = MARK_PASS | APPLY_PASS };
 inline bool isHot(uint8_t m) { return m == FIRE || m == LAVA; }   // ignites adjacent fuel
 
 // OIL and WOOD catch fire from an adjacent FIRE/LAVA. OIL ignites instantly; WOOD
 // smoulders (a per-cell frame hash gates it, so it burns slower). Two-pass
 // snapshot via the scratch buffer keeps it order-independent / GPU-identical.
-inline void igniteFire(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void igniteFire(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i];
@@ -248,7 +269,7 @@ inline void igniteFire(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
                     || (c == WOOD && hot && woodCatches(x, y, frame));                                       // wood: slow
             scratch[i] = ign ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) grid[i] = FIRE;
@@ -257,14 +278,14 @@ inline void igniteFire(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
 
 // Things meet hot: at an interface with FIRE or LAVA, WATER flashes to STEAM and
 // ACID boils off to SMOKE, while the FIRE is quenched to EMPTY and the LAVA freezes
-// to WALL (stone) wherever WATER touches it. One two-pass snapshot (the `moved`
-// scratch): pass 1 marks every reacting cell at such an interface, pass 2 transforms
+// to WALL (stone) wherever WATER touches it. One two-pass snapshot (through the
+// scratch buffer): pass 1 marks every reacting cell at such an interface, pass 2 transforms
 // each by its own type -- order-independent, GPU-identical.
-inline void quench(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
+inline void quench(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
     auto nb = [&](size_t i, uint8_t m) {
         return grid[i-1]==m || grid[i+1]==m || grid[i-SW]==m || grid[i+SW]==m;
     };
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i];
@@ -275,7 +296,7 @@ inline void quench(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int
             else if (c == LAVA)  react = nb(i, WATER);
             scratch[i] = react ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (!scratch[i]) continue;
@@ -290,16 +311,16 @@ inline void quench(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int
 // snapshot and writes only itself, so it's order-independent and GPU-identical.
 // Self-limiting: once plant lines a waterline, the remaining empty cells no
 // longer touch water.
-inline void growPlant(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
+inline void growPlant(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
     auto nb = [&](size_t i, uint8_t m) {
         return grid[i-1]==m || grid[i+1]==m || grid[i-SW]==m || grid[i+SW]==m;
     };
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             scratch[i] = (grid[i] == EMPTY && nb(i, PLANT) && nb(i, WATER) && plantGrows(x, y, frame)) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) grid[i] = PLANT;
@@ -310,16 +331,16 @@ inline void growPlant(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, i
 // (frame-hashed, so it bores through gradually). Two-pass snapshot via the
 // scratch buffer -> order-independent and GPU-identical. The interior-only sweep
 // never touches the padding border, so the WALL frame can't be eaten through.
-inline void dissolveAcid(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
+inline void dissolveAcid(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
     auto nb = [&](size_t i, uint8_t m) {
         return grid[i-1]==m || grid[i+1]==m || grid[i-SW]==m || grid[i+SW]==m;
     };
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             scratch[i] = (acidDissolves(grid[i]) && nb(i, ACID) && acidEats(x, y, frame)) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) grid[i] = EMPTY;
@@ -328,14 +349,14 @@ inline void dissolveAcid(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1
 
 // Glassmaking: SAND touching LAVA melts to GLASS (an inert solid). One two-pass
 // snapshot through the scratch buffer -> order-independent, GPU-identical.
-inline void makeGlass(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void makeGlass(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             scratch[i] = (grid[i] == SAND &&
                           (grid[i-1]==LAVA || grid[i+1]==LAVA || grid[i-SW]==LAVA || grid[i+SW]==LAVA)) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) grid[i] = GLASS;
@@ -347,14 +368,14 @@ inline void makeGlass(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, i
 // the scratch buffer -> order-independent, GPU-identical. The inverse of glassmaking,
 // and it feeds the existing water rules: ice dropped on lava melts, and that water
 // then quenches the lava to obsidian.
-inline void meltIce(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void meltIce(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             bool hot = isHot(grid[i-1]) || isHot(grid[i+1]) || isHot(grid[i-SW]) || isHot(grid[i+SW]);
             scratch[i] = ((grid[i] == ICE || grid[i] == SNOW) && hot && iceMelts(x, y, frame)) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) grid[i] = WATER;
@@ -366,14 +387,14 @@ inline void meltIce(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int
 // water but retreats wherever fire/lava thaws it, so heat and cold reach a little
 // equilibrium. Two-pass snapshot through the scratch buffer -> order-independent,
 // GPU-identical.
-inline void freezeWater(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void freezeWater(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             bool ice = grid[i-1]==ICE || grid[i+1]==ICE || grid[i-SW]==ICE || grid[i+SW]==ICE;
             scratch[i] = (grid[i] == WATER && ice && iceFreezes(x, y, frame)) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) grid[i] = ICE;
@@ -387,14 +408,14 @@ inline void freezeWater(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
 // moves and never depletes, so it is an endless fountain. This is the engine's
 // first rule that creates material from nothing (so it does not conserve mass --
 // only reachable when a spring is actually placed, never in the benchmark seed).
-inline void emitSpring(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void emitSpring(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             bool src = grid[i-1]==SPRING || grid[i+1]==SPRING || grid[i-SW]==SPRING || grid[i+SW]==SPRING;
             scratch[i] = (grid[i] == EMPTY && src && springFlows(x, y, frame)) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) grid[i] = WATER;
@@ -405,14 +426,14 @@ inline void emitSpring(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
 // the hot mirror of emitSpring (same order-independent mark/apply snapshot). The
 // VOLCANO never moves or depletes, so it is a perpetual lava vent, and the lava it
 // oozes then drives every heat reaction: ignition, glassmaking, steam, melt, blast.
-inline void emitVolcano(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void emitVolcano(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             bool src = grid[i-1]==VOLCANO || grid[i+1]==VOLCANO || grid[i-SW]==VOLCANO || grid[i+SW]==VOLCANO;
             scratch[i] = (grid[i] == EMPTY && src && volcanoFlows(x, y, frame)) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) grid[i] = LAVA;
@@ -425,15 +446,15 @@ inline void emitVolcano(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
 // and vanishes: a drain. Two-pass snapshot (mark consumed cells, then clear them),
 // so it's order-independent and GPU-identical -- the sink twin of the spring/volcano
 // sources.
-inline void consumeVoid(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void consumeVoid(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i];
             bool nearVoid = grid[i-1]==VOID || grid[i+1]==VOID || grid[i-SW]==VOID || grid[i+SW]==VOID;
             scratch[i] = (c != EMPTY && c != WALL && c != VOID && nearVoid) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) grid[i] = EMPTY;
@@ -445,8 +466,8 @@ inline void consumeVoid(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
 // with which way it goes (1 = wet to mud, 2 = bake to sand), pass 2 applies -- so
 // it's order-independent and GPU-identical. Frame-hashed, so shores muddy and bake
 // gradually rather than all at once.
-inline void mudCycle(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void mudCycle(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -459,7 +480,7 @@ inline void mudCycle(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, in
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = MUD;
@@ -473,8 +494,8 @@ inline void mudCycle(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, in
 // outpaces decay, it spreads as an expanding wave that leaves emptiness behind and
 // stops at WALL. Pass 1 marks each cell (1 = infect, 2 = die), pass 2 applies, so
 // it's order-independent and GPU-identical.
-inline void spreadVirus(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void spreadVirus(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -487,7 +508,7 @@ inline void spreadVirus(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = VIRUS;
@@ -503,8 +524,8 @@ inline void spreadVirus(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
 // 2=boil to steam, 3=fizzle, 4=ignite; then apply), order-independent and
 // GPU-identical. Boiling (not returning to water) is what makes it terminate instead
 // of oscillating forever.
-inline void arcSpark(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void arcSpark(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -515,7 +536,7 @@ inline void arcSpark(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, in
             else if (c == GAS || c == OIL || c == WISP || c == FUMES) { if (nSpark) r = 4; }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t v = scratch[i];
@@ -538,8 +559,8 @@ inline void arcSpark(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, in
 // the lava in the earlier quench pass, so the boundary resolves rather than oscillating).
 // One combined two-pass snapshot (mark 1=water->frost advance, 3=frost->ice crystallise,
 // 4=plant->empty wither, 5=frost->water melt; then apply), order-independent / GPU-identical.
-inline void spreadFrost(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void spreadFrost(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -554,7 +575,7 @@ inline void spreadFrost(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t v = scratch[i];
@@ -584,8 +605,8 @@ inline bool coalAshes(int x, int y, uint32_t frame) {
 // down to ASH, so the burn is long but finite. One combined two-pass snapshot (mark
 // 1=coal catches -> ember, 2=this cell is an ember; then apply: 1->EMBER, 2->ASH-or-stay,
 // and EMPTY next to an ember -> FIRE), order-independent and GPU-identical.
-inline void smoulderCoal(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void smoulderCoal(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -598,7 +619,7 @@ inline void smoulderCoal(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t v = scratch[i];
@@ -620,8 +641,8 @@ inline void smoulderCoal(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1
 // neighbour is such a loaded cloner with that stored material. Pass 2 reads only the
 // pass-1 scratch of its neighbour plus its own grid cell -- never a neighbour's live grid
 // cell -- so it stays order-independent and GPU-identical (no read/write race).
-inline void cloneMaterial(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void cloneMaterial(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t r = 0;
@@ -631,7 +652,7 @@ inline void cloneMaterial(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (grid[i] == EMPTY && scratch[i-SW] != 0) grid[i] = scratch[i-SW];
@@ -653,8 +674,8 @@ inline bool crystalGrows(int x, int y, uint32_t frame) {
 // branching gem instead of a solid flood. Two snapshot passes (mark the eligible empties,
 // then apply), order-independent and GPU-identical -- like plant growth, but counting
 // neighbours instead of needing water.
-inline void growCrystal(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void growCrystal(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t r = 0;
@@ -665,7 +686,7 @@ inline void growCrystal(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) grid[i] = CRYSTAL;
@@ -687,14 +708,14 @@ inline bool isMatter(uint8_t m) { return m != EMPTY && m != ANTIMATTER; }
 // never created, only consumed, so its count strictly decreases and it always terminates --
 // a solid blob peels to fire from the outside in over a few frames (the exposed inner
 // layers annihilate against the fire their own surface just made), leaving a clean cavity.
-inline void annihilate(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void annihilate(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             bool m = isMatter(grid[i-1]) || isMatter(grid[i+1]) || isMatter(grid[i-SW]) || isMatter(grid[i+SW]);
             scratch[i] = (grid[i] == ANTIMATTER && m) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) { grid[i] = FIRE; continue; }
@@ -718,8 +739,8 @@ inline bool mossAnchor(uint8_t m) { return m == WALL || m == OBSIDIAN || m == GL
 // (frame-hashed for a slow creep), so moss spreads only along the thin layer of empty cells
 // against a wall or timber -- greening structures without filling open space. A frame-hashed
 // mark/apply pair (each empty cell decides from a snapshot), order-independent / GPU-identical.
-inline void growMoss(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void growMoss(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t r = 0;
@@ -730,7 +751,7 @@ inline void growMoss(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, in
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) grid[i] = MOSS;
@@ -746,8 +767,8 @@ inline void growMoss(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, in
 // carrying the NEXT material id (like the cloner): pass 1 computes every cell's next state
 // from the grid snapshot, pass 2 applies it. scratch == 0 means "not a wire cell, leave it"
 // (wire cells never become EMPTY, so 0 is a safe sentinel). Order-independent / GPU-identical.
-inline void wireWorld(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void wireWorld(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -760,7 +781,7 @@ inline void wireWorld(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, i
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) grid[i] = scratch[i];
@@ -774,14 +795,14 @@ inline void wireWorld(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, i
 // Wireworld pass, so it sees the head exactly as the CA advances it into the adjacent wire.
 // Two-pass snapshot (mark each IGNITER next to a head, then turn the EMPTY cells next to a
 // marked igniter into FIRE), order-independent and GPU-identical -- a one-shot volcano of fire.
-inline void fireIgniter(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void fireIgniter(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             bool e = grid[i-1]==EHEAD || grid[i+1]==EHEAD || grid[i-SW]==EHEAD || grid[i+SW]==EHEAD;
             scratch[i] = (grid[i] == IGNITER && e) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (grid[i] == EMPTY) {
@@ -804,14 +825,14 @@ inline bool detectable(uint8_t m) {
 // WIRE next to a marked sensor into EHEAD. The injected head is propagated by the wireworld
 // pass on the following frame; while the trigger persists the sensor re-fires periodically
 // (the wire cycles head->tail->wire before it can be relit), so a steady touch is a clock.
-inline void senseWorld(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void senseWorld(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             bool d = detectable(grid[i-1]) || detectable(grid[i+1]) || detectable(grid[i-SW]) || detectable(grid[i+SW]);
             scratch[i] = (grid[i] == SENSOR && d) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (grid[i] == WIRE) {
@@ -827,8 +848,8 @@ inline void senseWorld(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
 // LIFE-or-EMPTY cell's fate (1 = live next, 2 = empty next, 0 = leave it -- which keeps any
 // other material untouched, so it blocks births and gliders thread through the falling world),
 // pass 2 applies. Order-independent / GPU-identical.
-inline void conwayLife(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void conwayLife(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -840,7 +861,7 @@ inline void conwayLife(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = LIFE;
@@ -863,15 +884,15 @@ inline bool geyserSprays(int x, int y, uint32_t frame) {
 // into the empty cells around it on a frame-hash for texture; the steam rises and condenses
 // back to water through the existing cycle, so a geyser gushes and rains on a rhythm. Same
 // order-independent mark/apply snapshot as emitSpring.
-inline void eruptGeyser(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
+inline void eruptGeyser(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
     if (!geyserErupts(frame)) return;   // dormant: leave the grid (and scratch) untouched
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             bool src = grid[i-1]==GEYSER || grid[i+1]==GEYSER || grid[i-SW]==GEYSER || grid[i+SW]==GEYSER;
             scratch[i] = (grid[i] == EMPTY && src && geyserSprays(x, y, frame)) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) grid[i] = STEAM;
@@ -882,8 +903,8 @@ inline void eruptGeyser(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
 // -> salt + water -- so the ACID is spent to WATER and the LYE to SALT, both existing materials.
 // Two-pass snapshot: pass 1 marks each LYE that touches acid (-> 1, becomes SALT) and each ACID
 // that touches lye (-> 2, becomes WATER); pass 2 applies. Order-independent / GPU-identical.
-inline void neutraliseLye(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void neutraliseLye(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -894,7 +915,7 @@ inline void neutraliseLye(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = SALT;
@@ -910,15 +931,15 @@ inline void neutraliseLye(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X
 // each marked cell into FIRE and boils each WATER beside a marked cell to STEAM. The FIRE it
 // makes is itself hot, so a pile chain-reacts outward one ring per frame. The chemistry
 // counterpart to the inert SAND it resembles, and a sibling to ACID/LYE/SALT.
-inline void reactSodium(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void reactSodium(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             bool trig = grid[i-1]==WATER || grid[i+1]==WATER || grid[i-SW]==WATER || grid[i+SW]==WATER
                      || isHot(grid[i-1]) || isHot(grid[i+1]) || isHot(grid[i-SW]) || isHot(grid[i+SW]);
             scratch[i] = (grid[i] == SODIUM && trig) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) { grid[i] = FIRE; continue; }
@@ -941,8 +962,8 @@ inline bool coralGrows(int x, int y, uint32_t frame) {
     uint32_t h = ((uint32_t)x * 151u + (uint32_t)y * 101u + frame * 181u) & 0xFFu;
     return h < CORAL_GROW;
 }
-inline void growCoral(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void growCoral(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t r = 0;
@@ -955,7 +976,7 @@ inline void growCoral(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, i
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = CORAL;
@@ -977,8 +998,8 @@ inline bool phosphorusBurns(int x, int y, uint32_t frame) {
     uint32_t h = ((uint32_t)x * 199u + (uint32_t)y * 113u + frame * 173u) & 0xFFu;
     return h < PHOS_IGNITE;
 }
-inline void ignitePhosphorus(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void ignitePhosphorus(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t r = 0;
@@ -989,7 +1010,7 @@ inline void ignitePhosphorus(uint8_t* grid, uint8_t* scratch, int SW, int X0, in
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = FIRE;
@@ -1009,14 +1030,14 @@ inline bool cementSets(int x, int y, uint32_t frame) {
     uint32_t h = ((uint32_t)x * 61u + (uint32_t)y * 157u + frame * 97u) & 0xFFu;
     return h < CEMENT_SET;
 }
-inline void hardenCement(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void hardenCement(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             // supported = the cell below is occupied (settled, not falling through air)
             scratch[i] = (grid[i] == CEMENT && grid[i+SW] != EMPTY && cementSets(x, y, frame)) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = WALL;
@@ -1037,8 +1058,8 @@ inline bool chlorineFades(int x, int y, uint32_t frame) {
     return h < CHLORINE_FADE;
 }
 inline bool chlorineKills(uint8_t m) { return m == PLANT || m == MOSS || m == CORAL; }
-inline void reactChlorine(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void reactChlorine(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -1054,7 +1075,7 @@ inline void reactChlorine(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = SALT;
@@ -1073,15 +1094,15 @@ inline void reactChlorine(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X
 // battery on a pulse frame; pass 2 lights it to EHEAD. Runs after the wireworld pass,
 // so an injected head begins propagating on the next frame.
 static constexpr uint32_t BATTERY_PERIOD = 12;   // a one-frame pulse every 12 frames
-inline void emitBattery(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
+inline void emitBattery(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
     bool pulse = (frame % BATTERY_PERIOD) == 0u;
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             scratch[i] = (pulse && grid[i] == WIRE &&
                           (grid[i-1]==BATTERY || grid[i+1]==BATTERY || grid[i-SW]==BATTERY || grid[i+SW]==BATTERY)) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = EHEAD;
@@ -1099,8 +1120,8 @@ inline void emitBattery(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
 // light it. Two-pass snapshot: pass 1 marks each FUSE that catches (-> BURNFUSE) and
 // each BURNFUSE that burns out (-> FIRE); pass 2 applies. Order-independent / GPU-identical.
 inline bool litsFuse(uint8_t m) { return m == FIRE || m == LAVA || m == EMBER || m == BURNFUSE; }
-inline void burnFuse(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void burnFuse(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -1111,7 +1132,7 @@ inline void burnFuse(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, in
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = BURNFUSE;
@@ -1133,8 +1154,8 @@ inline bool cryoEvaporates(int x, int y, uint32_t frame) {
     uint32_t h = ((uint32_t)x * 109u + (uint32_t)y * 233u + frame * 47u) & 0xFFu;
     return h < CRYO_EVAP;
 }
-inline void reactCryo(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void reactCryo(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -1152,7 +1173,7 @@ inline void reactCryo(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, i
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = ICE;
@@ -1170,8 +1191,8 @@ inline void reactCryo(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, i
 // pulse runs past -- a marquee -- and a battery-clocked wire makes a lamp blink. Build
 // glowing signs, bar displays, running lights. Two-pass snapshot: pass 1 marks each LAMP a
 // passing electron lights and each LAMPLIT no longer beside one (which dims); pass 2 applies.
-inline void lampLogic(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void lampLogic(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -1181,7 +1202,7 @@ inline void lampLogic(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, i
             else if (c == LAMPLIT) { if (!nearE) r = 2; }   // dims when the pulse leaves
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = LAMPLIT;
@@ -1199,8 +1220,8 @@ inline void lampLogic(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, i
 // snapshot: pass 1 marks each living cell beside the curse (-> PETRIFY) and each PETRIFY
 // (-> OBSIDIAN); pass 2 applies. Order-independent / GPU-identical.
 inline bool petrifiable(uint8_t m) { return m == PLANT || m == WOOD || m == MOSS || m == CORAL; }
-inline void petrify(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void petrify(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -1211,7 +1232,7 @@ inline void petrify(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = PETRIFY;
@@ -1234,8 +1255,8 @@ inline bool fireworkBursts(int x, int y, uint32_t frame) {
     uint32_t h = ((uint32_t)x * 71u + (uint32_t)y * 251u + frame * 139u) & 0xFFu;
     return h < FIREWORK_BURST;
 }
-inline void launchFirework(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void launchFirework(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t r = 0;
@@ -1247,7 +1268,7 @@ inline void launchFirework(uint8_t* grid, uint8_t* scratch, int SW, int X0, int
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 2)      grid[i] = FIRE;        // burst
@@ -1275,8 +1296,8 @@ inline bool treeCrowns(int x, int y, uint32_t frame) {
     uint32_t h = ((uint32_t)x * 167u + (uint32_t)y * 59u + frame * 233u) & 0xFFu;
     return h < TREE_LEAF;
 }
-inline void growTree(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void growTree(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t r = 0;
@@ -1288,7 +1309,7 @@ inline void growTree(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, in
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 2)      grid[i] = PLANT;     // crown leaf
@@ -1312,8 +1333,8 @@ inline void growTree(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, in
 // scratch buffer (the same trick CLONER uses) so the two passes never read a half-updated
 // grid. Sentinels in scratch: 254 = "this cell empties", 255 = "no change", else a material id.
 inline bool conveyable(uint8_t m) { return m != EMPTY && m != WALL && m != BELT; }
-inline void runConveyor(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void runConveyor(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t r = 255;                                                // no change
@@ -1324,7 +1345,7 @@ inline void runConveyor(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t r = scratch[i];
@@ -1342,8 +1363,8 @@ inline void runConveyor(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
 // pass 1 marks each IRON cell touching a MAGNET; pass 2 turns it to MAGNET. The magnet only
 // ever grows by consuming the iron it touches, so it terminates once the connected iron is
 // used up. Order-independent / GPU-identical.
-inline void magnetise(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void magnetise(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t r = 0;
@@ -1352,7 +1373,7 @@ inline void magnetise(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, i
                 r = 1;
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = MAGNET;
@@ -1372,8 +1393,8 @@ inline bool rustTicks(int x, int y, uint32_t frame) {
     uint32_t h = ((uint32_t)x * 131u + (uint32_t)y * 79u + frame * 197u) & 0xFFu;
     return h < RUST_RATE;
 }
-inline void rustCycle(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void rustCycle(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -1387,7 +1408,7 @@ inline void rustCycle(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, i
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = RUST;
@@ -1408,8 +1429,8 @@ inline bool seedGerminates(int x, int y, uint32_t frame) {
     uint32_t h = ((uint32_t)x * 89u + (uint32_t)y * 197u + frame * 151u) & 0xFFu;
     return h < SEED_RATE;
 }
-inline void germinateSeed(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void germinateSeed(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t r = 0;
@@ -1420,7 +1441,7 @@ inline void germinateSeed(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = SPROUT;
@@ -1440,14 +1461,14 @@ inline bool beamBurns(uint8_t m) {            // flammables a beam ignites on co
     return m == WOOD || m == PLANT || m == OIL || m == GAS || m == WISP
         || m == MOSS || m == FUMES || m == COAL || m == SEED;
 }
-inline void laserBeam(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void laserBeam(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i];
             scratch[i] = (c == BEAM) ? 1 : (c == LASER) ? 2 : beamBurns(c) ? 3 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t left = scratch[i-1];           // beam travels right: every cell looks to its left
@@ -1471,8 +1492,8 @@ inline bool icicleStops(int x, int y, uint32_t frame) {
     uint32_t h = ((uint32_t)x * 113u + (uint32_t)y * 167u + frame * 211u) & 0xFFu;
     return h < ICICLE_STOP;
 }
-inline void growIcicle(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void growIcicle(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t r = 0;
@@ -1483,7 +1504,7 @@ inline void growIcicle(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1,
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 2)      grid[i] = ICE;       // the tip solidifies into the body
@@ -1510,8 +1531,8 @@ inline bool saltDissolves(int x, int y, uint32_t frame) {
 // then disappears into the meltwater. One combined two-pass snapshot (mark 1=salt
 // dissolves to empty, 2=ice melts to water; then apply), order-independent and
 // GPU-identical.
-inline void saltCycle(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void saltCycle(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             uint8_t c = grid[i], r = 0;
@@ -1524,7 +1545,7 @@ inline void saltCycle(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, i
             }
             scratch[i] = r;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i] == 1) grid[i] = EMPTY;
@@ -1540,14 +1561,14 @@ inline bool mercuryPoisons(int x, int y, uint32_t frame) {
 // Mercury poisoning: PLANT touching the toxic liquid metal MERCURY withers to EMPTY
 // (frame-hashed, so a vine dies back gradually). Two-pass snapshot -> order-
 // independent and GPU-identical.
-inline void poisonMercury(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    for (int y = Y0; y < Y1; ++y)
+inline void poisonMercury(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             bool merc = grid[i-1]==MERCURY || grid[i+1]==MERCURY || grid[i-SW]==MERCURY || grid[i+SW]==MERCURY;
             scratch[i] = (grid[i] == PLANT && merc && mercuryPoisons(x, y, frame)) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) grid[i] = EMPTY;
@@ -1568,14 +1589,14 @@ inline bool blastable(uint8_t m) {
 // one -- into FIRE. Pass 2 reads the pass-1 marks (in scratch) plus its own grid
 // cell, writing only itself, so it stays order-independent and GPU-identical. The
 // blast wave then expands one ring per frame as the new fire detonates the next TNT.
-inline void detonateTnt(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void detonateTnt(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             bool hot = isHot(grid[i-1]) || isHot(grid[i+1]) || isHot(grid[i-SW]) || isHot(grid[i+SW]);
             scratch[i] = ((grid[i] == TNT || grid[i] == GUNPOWDER || grid[i] == NITRO) && hot) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             bool nearBlast = scratch[i-1] || scratch[i+1] || scratch[i-SW] || scratch[i+SW] ||
@@ -1598,14 +1619,14 @@ inline bool meltable(uint8_t m) {
 // pass-1 marks (in scratch) of its 4 neighbours plus its own grid cell, writing only
 // itself, so it stays order-independent and GPU-identical. The burn front advances
 // one ring per frame (the new fire lights the next thermite), eating a molten cavity.
-inline void burnThermite(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
-    for (int y = Y0; y < Y1; ++y)
+inline void burnThermite(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes = BOTH_PASSES) {
+    if (passes & MARK_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             bool hot = isHot(grid[i-1]) || isHot(grid[i+1]) || isHot(grid[i-SW]) || isHot(grid[i+SW]);
             scratch[i] = (grid[i] == THERMITE && hot) ? 1 : 0;
         }
-    for (int y = Y0; y < Y1; ++y)
+    if (passes & APPLY_PASS) for (int y = Y0; y < Y1; ++y)
         for (int x = X0; x < X1; ++x) {
             size_t i = (size_t)y * SW + x;
             if (scratch[i]) { grid[i] = FIRE; continue; }
@@ -1613,3 +1634,30 @@ inline void burnThermite(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1
             if (nearBurn && meltable(grid[i])) grid[i] = LAVA;
         }
 }
+
+// The frame-dependent rules -- the ones a frame hash or a clock decides -- by the
+// materials that must meet for one to fire: a member of `a` with a member of `b` in
+// reach (an empty `b` needs only `a`). Every other rule, and the movement step, is a
+// pure function of the grid, so a region where none of these combinations can occur
+// and nothing changed last frame cannot change this frame either; the host lets such
+// chunks sleep. A new hashed or clocked rule must add its row here.
+struct TimedRule { MatMask a, b; };
+static constexpr TimedRule kTimedRules[] = {
+    {{FIRE, SMOKE, STEAM, ACID}, {}},                  // decayFire, dissolveAcid
+    {{WOOD}, {FIRE, LAVA}},                            // igniteFire (wood smoulders)
+    {{PLANT}, {WATER, MERCURY}},                       // growPlant, poisonMercury
+    {{ICE, SNOW}, {FIRE, LAVA}},                       // meltIce
+    {{ICE}, {WATER, SALT}},                            // freezeWater, saltCycle
+    {{SAND}, {WATER}}, {{MUD}, {FIRE, LAVA}},          // mudCycle
+    {{SALT}, {WATER}},                                 // saltCycle
+    {{CORAL}, {WATER}},                                // growCoral
+    {{IRON}, {WATER, ACID}}, {{RUST}, {FIRE, LAVA}},   // rustCycle
+    {{SEED}, {WATER}},                                 // germinateSeed
+    {{SPRING, VOLCANO, VIRUS, EMBER, CRYSTAL, MOSS, GEYSER, PHOSPHORUS, CEMENT,
+      CHLORINE, BATTERY, CRYO, FIREWORK, SPROUT, ICICLE}, {}},   // sources, growth, clocks
+};
+inline bool timedRuleMayFire(const MatMask& present) {
+    for (const TimedRule& r : kTimedRules)
+        if (present.meets(r.a) && (r.b.empty() || present.meets(r.b))) return true;
+    return false;
+}
@@ -0,0 +1,262 @@
+// Bitplane movement: the 16 sub-passes of simdStep() on the rectangle transposed into
+// bitplanes. A material id fits in 7 bits, so 64 cells of a row are 7 uint64_t words
+// (bit k of plane p is bit p of cell k's id) plus one word of their `moved` flags, and
+// every step of a sub-pass is word-wide logic over 64 cells:
+//   * which cells are of a mover / target class is a boolean function of the 7 bits:
+//     "id == m" is one AND of its decoded low and high nibble, ORed over the materials
+//     of the class -- only those the window holds (see moveBanks()) -- and is taken
+//     once per group of sub-passes, not per move;
+//   * a move is (source class & target class of the cell dx, dy away) & both free &
+//     the sub-pass's source cells, with the target row shifted a bit either way for
+//     the diagonal and horizontal moves;
+//   * the swap is an XOR: d = (source ^ target) & move, applied to both sides.
+// A row is worked a plane at a time, each step one loop over its words with the
+// neighbouring word shifted in, so the compiler runs it several words to an
+// instruction. The moves of a sub-pass pair disjoint cells (see simd_core.h), so the
+// result is simdStep()'s exactly. Column parity and the 16-lane groups no horizontal
+// move crosses are taken from X0 the same way, so the rectangle must be whole 64-cell
+// spans wide (the host's chunks are).
+//
+// The grid stays bytes -- the reactions, the sleep bookkeeping and the renderer all
+// read it -- so the planes are built when a rectangle's frame starts and written back
+// when it ends. That costs about two sub-passes of byte traffic.
+#pragma once
+#include "simd_core.h"
+#include <type_traits>
+
+// The window's materials in each mover (or target) class bit of one group: class bit
+// b is the ids [start[b], start[b + 1]), as their low and high nibbles; los[b] and
+// his[b] flag the nibbles it uses.
+struct PlaneClass { int start[9]; uint8_t lo[8 * MATERIAL_COUNT], hi[8 * MATERIAL_COUNT]; uint32_t los[8], his[8]; };
+template <class Ops>
+PlaneClass planeClass(const uint8_t* table, const uint64_t* mats) {
+    PlaneClass c{};
+    int n = 0;
+    for (int b = 0; b < 8; ++b) {
+        c.start[b] = n;
+        for (int m = 0; m < MATERIAL_COUNT; ++m)
+            if (((table[m] >> b) & 1) && (!mats || ((mats[m >> 6] >> (m & 63)) & 1))) {
+                c.lo[n] = m & 15; c.hi[n++] = (uint8_t)(m >> 4);
+                c.los[b] |= 1u << (m & 15); c.his[b] |= 1u << (m >> 4);
+            }
+    }
+    c.start[8] = n;
+    return c;
+}
+
+// The class planes of one row of nw words, pl[p] its id planes: out[b * stride + w] is
+// "in class bit b", for the class bits b in `want`. The nibbles they need are decoded
+// first, a word loop each, into `dec` (36 * nw words). Returns the bits some cell has.
+template <class Ops>
+uint32_t classifyRow(const uint64_t* const* pl, int nw, const PlaneClass& c, uint32_t want, uint64_t* dec,
+                     uint64_t* out, int stride) {
+    uint32_t los = 0, his = 0;
+    for (int b = 0; b < 8; ++b)
+        if ((want >> b) & 1) { los |= c.los[b]; his |= c.his[b]; }
+    if (!los) return 0;
+    uint64_t* two = dec;                              // 3 bit pairs x 4 values
+    uint64_t* lo = dec + 12 * nw;                     // 16 low nibbles
+    uint64_t* hi = dec + 28 * nw;                     // 8 high nibbles
+    for (int q = 0; q < 3; ++q) {
+        const uint64_t* x = pl[2 * q];
+        const uint64_t* y = pl[2 * q + 1];
+        uint64_t* t = two + 4 * q * nw;
+        for (int w = 0; w < nw; ++w) {
+            t[w] = ~(x[w] | y[w]); t[nw + w] = x[w] & ~y[w]; t[2 * nw + w] = ~x[w] & y[w]; t[3 * nw + w] = x[w] & y[w];
+        }
+    }
+    for (int v = 0; v < 16; ++v)
+        if ((los >> v) & 1) {
+            const uint64_t* a = two + (v & 3) * nw;
+            const uint64_t* b = two + (4 + (v >> 2)) * nw;
+            for (int w = 0; w < nw; ++w) lo[v * nw + w] = a[w] & b[w];
+        }
+    for (int v = 0; v < 8; ++v)
+        if ((his >> v) & 1) {
+            const uint64_t* a = two + (8 + (v & 3)) * nw;
+            const uint64_t flip = (v & 4) ? 0 : ~0ull;
+            for (int w = 0; w < nw; ++w) hi[v * nw + w] = a[w] & (pl[6][w] ^ flip);
+        }
+    uint32_t has = 0;
+    for (int b = 0; b < 8; ++b) {
+        if (!((want >> b) & 1)) continue;
+        uint64_t* o = out + (size_t)b * stride;
+        for (int w = 0; w < nw; ++w) o[w] = 0;
+        for (int i = c.start[b]; i < c.start[b + 1]; ++i) {
+            const uint64_t* l = lo + c.lo[i] * nw;
+            const uint64_t* h = hi + c.hi[i] * nw;
+            for (int w = 0; w < nw; ++w) o[w] |= l[w] & h[w];
+        }
+        uint64_t any = 0;
+        for (int w = 0; w < nw; ++w) any |= o[w];
+        has |= (uint32_t)(any != 0) << b;
+    }
+    return has;
+}
+
+// Word w of a plane, lined up with the source cells of a move DX columns away: bit k
+// is the cell k + DX, shifted in from the word beside it. Planes keep a zero word
+// either side, so a[-1] and a[nw] can be read.
+template <int DX>
+inline uint64_t alignedWord(const uint64_t* a, int w) {
+    if constexpr (DX > 0) return (a[w] >> 1) | (a[w + 1] << 63);
+    else if constexpr (DX < 0) return (a[w] << 1) | (a[w - 1] >> 63);
+    else return a[w];
+}
+// The bits of target word w that the source moves `d` flip: the inverse of the above.
+template <int DX>
+inline uint64_t targetWord(const uint64_t* d, int w) {
+    if constexpr (DX > 0) return (d[w] << 1) | (d[w - 1] >> 63);
+    else if constexpr (DX < 0) return (d[w] >> 1) | (d[w + 1] << 63);
+    else return d[w];
+}
+
+// One movement frame over [X0, X1) x [Y0, Y1) on bitplanes; the same cells and
+// `moved` flags as simdStep(). (X1 - X0) % 64 == 0. Returns 0: nothing is skipped by
+// span summaries here.
+template <class Ops>
+uint64_t planeStep(uint8_t* grid, uint8_t* moved, int SW, int X0, int X1, int Y0, int Y1, const uint64_t* mats) {
+    using V = typename Ops::V;
+    const int W = Ops::W;
+    // Planes cover rows Y0-1 .. Y1 and columns X0-1 .. X1, every cell a move can reach;
+    // each row is 7 id planes and the moved plane, of nw words and a zero word each side.
+    const int ya = Y0 - 1, nr = Y1 - Y0 + 2, xa = X0 - 1, nc = X1 - X0 + 2, nw = (nc + 63) / 64, np = nw + 2;
+    std::vector<uint64_t> buf((size_t)nr * 8 * np, 0);
+    auto plane = [&](int y, int p) { return &buf[((size_t)(y - ya) * 8 + p) * np + 1]; };
+    auto movedRow = [&](int y) { return moved + (size_t)(y >> 3) * SW; };
+
+    std::memset(movedRow(Y0), 0, (size_t)((Y1 + 7) / 8 - Y0 / 8) * SW);   // as simdStep()
+    for (int y = ya; y <= Y1; ++y) {
+        const uint8_t* g = grid + (size_t)y * SW + xa;
+        const uint8_t* mv = movedRow(y) + xa;
+        const uint8_t bit = (uint8_t)(1 << (y & 7));
+        for (int w = 0; w < nw; ++w) {
+            const int x = 64 * w, n = std::min(64, nc - x);
+            uint64_t ids[7] = {}, mvd = 0;
+            if (n == 64)
+                for (int k = 0; k < 64; k += W) {
+                    const V c = Ops::loadu(g + x + k);
+                    for (int p = 0; p < 7; ++p) ids[p] |= Ops::bits(Ops::testnz(c, Ops::set1(1 << p))) << k;
+                    mvd |= Ops::bits(Ops::testnz(Ops::loadu(mv + x + k), Ops::set1(bit))) << k;
+                }
+            else
+                for (int k = 0; k < n; ++k) {
+                    for (int p = 0; p < 7; ++p) ids[p] |= (uint64_t)((g[x + k] >> p) & 1) << k;
+                    mvd |= (uint64_t)((mv[x + k] & bit) != 0) << k;
+                }
+            for (int p = 0; p < 7; ++p) plane(y, p)[w] = ids[p];
+            plane(y, 7)[w] = mvd;
+        }
+    }
+
+    // Source columns X0 .. X1-1 are bits 1 .. nc-2. X0 - 1 is bit 0, so a column an
+    // even distance from X0 is an odd bit, and a 16-lane group starts at bit 16j + 1.
+    std::vector<uint64_t> cols(nw);
+    for (int w = 0; w < nw; ++w)
+        for (int k = 0; k < 64; ++k) {
+            const int j = 64 * w + k;
+            if (j >= 1 && j < nc - 1) cols[w] |= 1ull << k;
+        }
+    const uint64_t EVEN = 0xAAAAAAAAAAAAAAAAull, ODD = ~EVEN;
+    const uint64_t GROUP_START = 0x0002000200020002ull, GROUP_END = 0x0001000100010001ull;
+
+    PlaneClass mover[3], target[3];
+    for (int g = 0; g < 3; ++g) { mover[g] = planeClass<Ops>(kMoveLut[g].mover, mats); target[g] = planeClass<Ops>(kMoveLut[g].target, mats); }
+    // The class planes of every row, for the group of the sub-passes under way. They are
+    // taken once per group: a cell only changes by a swap, and that sets `moved` on both
+    // sides, so a stale class is never read for a cell that can still move.
+    std::vector<uint64_t> dec((size_t)36 * nw), mc((size_t)nr * 8 * nw), tc((size_t)nr * 8 * np, 0), mk(nw), can(nw), d(np, 0);
+    std::vector<uint32_t> rowLive(nr);
+    uint32_t live = 0;
+    auto classify = [&](int g) {
+        live = 0;
+        for (int y = ya; y <= Y1; ++y) {
+            const uint64_t* pl[7];
+            for (int p = 0; p < 7; ++p) pl[p] = plane(y, p);
+            rowLive[y - ya] = classifyRow<Ops>(pl, nw, mover[g], 0xFF, dec.data(), &mc[(size_t)(y - ya) * 8 * nw], nw);
+            live |= rowLive[y - ya];
+        }
+        // Only the classes some row's movers are in are looked for in the targets.
+        for (int y = ya; y <= Y1; ++y) {
+            const uint64_t* pl[7];
+            for (int p = 0; p < 7; ++p) pl[p] = plane(y, p);
+            classifyRow<Ops>(pl, nw, target[g], live, dec.data(), &tc[(size_t)(y - ya) * 8 * np + 1], np);
+        }
+    };
+
+    // Source row y moves into row y + dy, DX columns across, where `lanes` allow.
+    auto moveRow = [&](auto DX, int y, int dy, uint64_t lanes) {
+        constexpr int dx = decltype(DX)::value;
+        const uint32_t rl = rowLive[y - ya];
+        if (!rl) return;
+        uint64_t* sp[8];
+        uint64_t* tp[8];
+        for (int p = 0; p < 8; ++p) { sp[p] = plane(y, p); tp[p] = plane(y + dy, p); }
+        for (int w = 0; w < nw; ++w) mk[w] = cols[w] & lanes & ~(sp[7][w] | alignedWord<dx>(tp[7], w));
+        for (int w = 0; w < nw; ++w) can[w] = 0;
+        for (int b = 0; b < 8; ++b) {
+            if (!((rl >> b) & 1)) continue;
+            const uint64_t* m = &mc[((size_t)(y - ya) * 8 + b) * nw];
+            const uint64_t* t = &tc[((size_t)(y + dy - ya) * 8 + b) * np + 1];
+            for (int w = 0; w < nw; ++w) can[w] |= m[w] & alignedWord<dx>(t, w);
+        }
+        uint64_t any = 0;
+        for (int w = 0; w < nw; ++w) { mk[w] &= can[w]; any |= mk[w]; }
+        if (!any) return;
+        // d comes from the planes before either side changes, so both sides flip in one
+        // pass over the words -- also when they are the same row (a horizontal move).
+        uint64_t* dd = d.data() + 1;
+        for (int p = 0; p < 8; ++p) {
+            uint64_t* s = sp[p];
+            uint64_t* t = tp[p];
+            if (p < 7) for (int w = 0; w < nw; ++w) dd[w] = (s[w] ^ alignedWord<dx>(t, w)) & mk[w];
+            else       for (int w = 0; w < nw; ++w) dd[w] = mk[w];   // moved: set on both sides
+            for (int w = 0; w < nw; ++w) s[w] ^= dd[w];
+            for (int w = 0; w < nw; ++w) t[w] ^= targetWord<dx>(dd, w);
+        }
+    };
+    using Left = std::integral_constant<int, -1>;
+    using Still = std::integral_constant<int, 0>;
+    using Right = std::integral_constant<int, 1>;
+
+    int grp = -1;
+    for (const SubPass& p : kSubPasses) {
+        if (p.grp != grp) classify(grp = p.grp);
+        uint64_t lanes = p.parity == 0 ? EVEN : ODD;
+        if (p.type == 2 && p.dx < 0 && p.parity == 0) lanes &= ~GROUP_START;
+        if (p.type == 2 && p.dx > 0 && p.parity != 0) lanes &= ~GROUP_END;
+        if (p.type == 0)
+            for (int y = Y0 + p.parity; y < Y1; y += 2) moveRow(Still{}, y, p.dy, ~0ull);
+        else
+            for (int y = Y0; y < Y1; ++y)
+                if (p.dx < 0) moveRow(Left{}, y, p.dy, lanes);
+                else          moveRow(Right{}, y, p.dy, lanes);
+    }
+
+    for (int y = ya; y <= Y1; ++y) {
+        uint8_t* g = grid + (size_t)y * SW + xa;
+        uint8_t* mv = movedRow(y) + xa;
+        const uint8_t bit = (uint8_t)(1 << (y & 7));
+        for (int w = 0; w < nw; ++w) {
+            const int x = 64 * w, n = std::min(64, nc - x);
+            uint64_t ids[7];
+            for (int p = 0; p < 7; ++p) ids[p] = plane(y, p)[w];
+            const uint64_t mvd = plane(y, 7)[w];
+            if (n == 64)
+                for (int k = 0; k < 64; k += W) {
+                    V c = Ops::zero();
+                    for (int p = 0; p < 7; ++p) c = Ops::Or(c, Ops::select(Ops::lanes(ids[p] >> k), Ops::set1(1 << p)));
+                    Ops::storeu(g + x + k, c);
+                    Ops::storeu(mv + x + k, Ops::Or(Ops::loadu(mv + x + k), Ops::select(Ops::lanes(mvd >> k), Ops::set1(bit))));
+                }
+            else
+                for (int k = 0; k < n; ++k) {
+                    uint8_t c = 0;
+                    for (int p = 0; p < 7; ++p) c |= (uint8_t)(((ids[p] >> k) & 1) << p);
+                    g[x + k] = c;
+                    if ((mvd >> k) & 1) mv[x + k] |= bit;
+                }
+        }
+    }
+    return 0;
+}
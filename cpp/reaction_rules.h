@@ -0,0 +1,115 @@
+// The always-on neighbour-predicate reactions as data: one row per mark/apply pair, in
+// SimdReaction order (world_step.h). A row is a list of clauses, each read as
+//
+//   a cell of one of `self`, with one of `near` among its 4 neighbours (and, if set,
+//   one of `near2`), where the frame hash passes, is marked `mark`; the apply turns a
+//   cell marked `mark` into `into`.
+//
+// Clauses of a row have disjoint `self`, so at most one marks a cell. Clauses sharing
+// a mark pick their product by the cell's own material, the last one's `into` being
+// what the others are not (quench's obsidian), as in the scalar apply.
+//
+// The CPU's SIMD kernels (simd_react.h) and the fused sweep's triggers (kReactions)
+// are built from these rows at compile time, and tools/gen_reactions.cpp emits the
+// passes of both GPU shaders from them (checked in under tools/golden/). materials.h
+// keeps the scalar functions of the same names: the reference every row must
+// reproduce, mark for mark (tools/test_simd_react.cpp, tools/test_reaction_rules.cpp).
+#pragma once
+#include "materials.h"
+
+struct MatList {                     // up to 6 material ids
+    uint8_t id[6] = {};
+    int n = 0;
+    constexpr MatList() = default;
+    constexpr MatList(std::initializer_list<int> ms) { for (int m : ms) id[n++] = (uint8_t)m; }
+    constexpr MatMask mask() const { MatMask m; for (int k = 0; k < n; ++k) m.add(id[k]); return m; }
+};
+// `(x*ax + y*ay + frame*af) & 0xFF < below`; below 0: no hash, the clause always holds.
+struct RuleHash { uint8_t ax, ay, af, below; };
+static constexpr RuleHash kAlways{0, 0, 0, 0};
+
+struct RuleClause { MatList self, near, near2; RuleHash hash; uint8_t mark, into; };
+struct ReactionRule {
+    const char* name;      // the scalar function in materials.h
+    int type;              // its GPU mark pass; `type + 1` is the apply
+    RuleClause clause[4];  // ended by an empty `self`
+};
+
+static constexpr ReactionRule kReactionRules[] = {
+    {"igniteFire", 4, {
+        {{OIL, PLANT, GAS, WISP, MOSS, FUMES}, {FIRE, LAVA}, {}, kAlways, 1, FIRE},
+        {{WOOD}, {FIRE, LAVA}, {}, {149, 83, 157, WOOD_IGNITE}, 1, FIRE},      // woodCatches()
+    }},
+    {"quench", 6, {
+        {{WATER}, {FIRE, LAVA}, {}, kAlways, 1, STEAM},
+        {{ACID}, {FIRE, LAVA}, {}, kAlways, 1, SMOKE},
+        {{FIRE}, {WATER}, {}, kAlways, 1, EMPTY},
+        {{LAVA}, {WATER}, {}, kAlways, 1, OBSIDIAN},
+    }},
+    {"growPlant", 8, {
+        {{EMPTY}, {PLANT}, {WATER}, {113, 191, 71, PLANT_GROW}, 1, PLANT},   // plantGrows()
+    }},
+    {"dissolveAcid", 10, {
+        {{WALL, SAND, WOOD, PLANT}, {ACID}, {}, {53, 199, 89, ACID_EAT}, 1, EMPTY},   // acidDissolves(), acidEats()
+    }},
+    {"makeGlass", 12, {
+        {{SAND}, {LAVA}, {}, kAlways, 1, GLASS},
+    }},
+    {"meltIce", 14, {
+        {{ICE, SNOW}, {FIRE, LAVA}, {}, {127, 163, 41, ICE_MELT}, 1, WATER},   // iceMelts()
+    }},
+    {"freezeWater", 16, {
+        {{WATER}, {ICE}, {}, {181, 67, 103, ICE_FREEZE}, 1, ICE},             // iceFreezes()
+    }},
+    {"mudCycle", 26, {
+        {{SAND}, {WATER}, {}, {157, 97, 61, MUD_FORM}, 1, MUD},               // mudForms()
+        {{MUD}, {FIRE, LAVA}, {}, {83, 173, 109, MUD_BAKE}, 2, SAND},         // mudBakes()
+    }},
+};
+static constexpr int kRuleCount = sizeof(kReactionRules) / sizeof(kReactionRules[0]);
+
+constexpr int clauseCount(const ReactionRule& r) {
+    int k = 0;
+    while (k < 4 && r.clause[k].self.n) ++k;
+    return k;
+}
+// Whether every mark of the row is 1: its apply then acts on any set mark, like the
+// scalar `if (scratch[i])`.
+constexpr bool marksOne(const ReactionRule& r) {
+    for (int k = 0; k < clauseCount(r); ++k)
+        if (r.clause[k].mark != 1) return false;
+    return true;
+}
+// The first clause with mark m, and the last: the one whose `into` is the default.
+constexpr int firstWithMark(const ReactionRule& r, int m) {
+    for (int k = 0; k < clauseCount(r); ++k)
+        if (r.clause[k].mark == m) return k;
+    return -1;
+}
+constexpr int lastWithMark(const ReactionRule& r, int m) {
+    int last = -1;
+    for (int k = 0; k < clauseCount(r); ++k)
+        if (r.clause[k].mark == m) last = k;
+    return last;
+}
+
+// The row's trigger as two sets (Reaction::a/b): a clause can only fire where one of
+// its `self` and one of its `near` (or its two neighbour sets) meet, so each clause
+// puts one side into `a` and the other into `b` -- whichever way adds fewer materials.
+struct RuleTrigger { MatMask a, b, makes; };
+constexpr int newIds(const MatMask& into, const MatMask& m) {
+    int n = 0;
+    for (int i = 0; i < MATERIAL_COUNT; ++i) n += m.has(i) && !into.has(i);
+    return n;
+}
+constexpr RuleTrigger ruleTrigger(const ReactionRule& r) {
+    RuleTrigger t;
+    for (int k = 0; k < clauseCount(r); ++k) {
+        const RuleClause& c = r.clause[k];
+        const MatMask x = c.near.mask(), y = c.near2.n ? c.near2.mask() : c.self.mask();
+        if (newIds(t.a, x) + newIds(t.b, y) <= newIds(t.a, y) + newIds(t.b, x)) { t.a |= x; t.b |= y; }
+        else { t.a |= y; t.b |= x; }
+        t.makes.add(c.into);
+    }
+    return t;
+}
@@ -5,8 +5,9 @@
  * contiguous, WALL-bordered live grid with the single-grid SIMD technique. The
  * update rule lives in simd_core.h and is order-independent (disjoint even/odd
  * passes), so it produces a bit-identical world on CPU SIMD and the GPU compute
- * backends. The SIMD width is chosen at runtime: AVX2 (32 lanes) if the CPU has
- * it, otherwise SSE4.1 (16 lanes) -- see world_step.h. Both give the same result.
+ * backends. The SIMD width is chosen at runtime: AVX-512BW (64 lanes) or AVX2 (32
+ * lanes) if the CPU has it, otherwise SSE4.1 (16 lanes) -- see world_step.h. All
+ * give the same result.
  *
  * The live window is sized at runtime: the interactive view renders each cell as
  * a "virtual pixel" of SCALE x SCALE screen pixels, so the resident region is
@@ -16,13 +17,19 @@
  * Modes:
  *   (default)                 SDL2 window; arrows pan the camera by a chunk,
  *                             number keys pick a material, left mouse paints.
- *   --bench [steps] [wch] [hch]   headless streaming benchmark (fixed 4x4 live
- *                             window; whole-world checksum + conserved counts).
+ *   --bench [steps] [wch] [hch] [tiles]   headless streaming benchmark (fixed 4x4
+ *                             live window; whole-world checksum + conserved counts,
+ *                             then pass-major vs fused movement timings). `tiles`
+ *                             runs the task graph on GridLayout::Tiles.
  *   --ppm <file> [steps]      render a snapshot of one live window.
  */
 
 #include "materials.h"   // Material enum
-#include "world_step.h"  // runtime SSE/AVX2 step dispatch
+#include "reaction_rules.h"   // the neighbour reactions as a table (kReactions, simd_react.h)
+#include "world_step.h"  // runtime SSE/AVX2/AVX-512 step dispatch
+#include "thread_pool.h" // --threads: the step's worker team
+#include "wavefront.h"   // --threads: (chunk, pass) task graph
+#include "grid_buffer.h" // cache-line aligned, huge-page backed live grid
 #include "../ui.h"       // on-screen material palette
 #include <cstdint>
 #include <cstdio>
@@ -32,11 +39,25 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <numeric>
 #include <fstream>
 #include <filesystem>
+#include <memory>
+#include <atomic>
+#include <cmath>
 #include <SDL2/SDL.h>
 
-static StepFn g_step = nullptr;   // selected at startup (AVX2 or SSE)
+static StepFn g_step = nullptr;   // selected at startup (AVX-512, AVX2 or SSE)
+static BandStepFn g_bandStep = nullptr;   // the same step, one row band per thread
+static TaskStepFn g_taskStep = nullptr;   // the same step, one pass of one chunk
+static ReactStepFn g_react = nullptr;     // the vectorised reactions (SimdReaction)
+static int g_threads = 1;         // --threads N / SANDSIM_THREADS
+static void selectKernels() {
+    g_step = planeMove() ? selectPlaneStep() : fusedMove() ? selectFusedStep() : selectStep();   // AVX-512, AVX2 or SSE
+    g_bandStep = selectBandStep();
+    g_react = selectReact();
+    g_taskStep = selectTaskStep();
+}
 static const uint32_t kColors[MATERIAL_COUNT] = {
     0xFF000000u, 0xFF808080u, 0xFFE2C878u, 0xFF4488FFu, 0xFFB0C4DEu, 0xFF8E44ADu, 0xFFFF5A1Eu, 0xFFCF1B0Bu, 0xFFDCE4ECu, 0xFF8B5A2Bu, 0xFF3AA84Au, 0xFFB8F000u, 0xFF585860u, 0xFFAEE0E8u, 0xFFCDEBFFu, 0xFF1FB5C4u, 0xFFCC2222u, 0xFF6B6358u, 0xFF402A28u, 0xFF3C1452u, 0xFF4E3B24u, 0xFFD81E9Bu, 0xFFFAF080u, 0xFF2A2438u, 0xFFEDEDE0u, 0xFFEAF4FFu, 0xFFC4C8D4u, 0xFF3A3A40u, 0xFF8A3A1Fu, 0xFFAEF0FFu, 0xFF9EF5B5u, 0xFF26221Eu, 0xFFCC4411u, 0xFF9A40E6u, 0xFF40E0C0u, 0xFFCDA0FFu, 0xFF6E8B3Du, 0xFFCBC75Au, 0xFFC8862Eu, 0xFF80E0FFu, 0xFF3A6AB0u, 0xFFD89020u, 0xFFB0E040u, 0xFF50FF90u, 0xFF5090A0u, 0xFFC8E8D0u, 0xFFD7D0B0u, 0xFFFF8C69u, 0xFFEFE8A0u, 0xFF7E8C99u, 0xFFB6E03Au, 0xFFFFCC22u, 0xFF9A8050u, 0xFFFFD030u, 0xFF88D0F8u, 0xFF4A4030u, 0xFFFFF0A0u, 0xFFB098A8u, 0xFFFF50C0u, 0xFFB060FFu, 0xFF70D838u, 0xFF454C50u, 0xFF5878B8u, 0xFF788088u, 0xFFC8E070u, 0xFFA85020u, 0xFFB5832Eu, 0xFF901818u, 0xFFFF3030u, 0xFFE8F8FFu,
 };
@@ -56,6 +77,7 @@ static constexpr int PAD = 16;     // WALL border / SIMD halo
 // view. simHz is steps/second, decoupled from the render rate so the physics runs
 // at the same wall-clock speed on every backend.
 struct ViewCfg { int winW = 1024, winH = 768, scale = 3, simHz = 60; };
+#ifndef SANDSIM_NO_MAIN
 static ViewCfg parseView(int argc, char* argv[]) {
     ViewCfg c;
     if (const char* e = getenv("SANDSIM_RES"))   std::sscanf(e, "%dx%d", &c.winW, &c.winH);
@@ -72,19 +94,200 @@ static ViewCfg parseView(int argc, char* argv[]) {
     if (c.winH < CHUNK * c.scale) c.winH = CHUNK * c.scale;
     return c;
 }
+#endif
 
 #include "../worldgen.h"   // shared deterministic seedMat() (diverse world, all backends)
+#include "../reaction_gates.h"   // shared per-pass reaction gates (all backends)
+
+// The reaction passes in frame order; reaction i is GPU pass types 2i+2/2i+3 (decayFire
+// is type 3). A pass runs only once one of its `gate` materials has been resident (an
+// empty gate: always, while anything reactive is); the gates are the table all three
+// backends share (reaction_gates.h).
+// `reach` is how far one pass can carry an effect, in cells: 1 for a mark/apply pair
+// that reads its neighbours' grid cells, 2 when pass 2 also reads its neighbours'
+// marks (0 for decayFire, which reads nothing around it). A reach-1 apply leaves a
+// cell whose mark is 0 as it is (the fused sweep applies only the marked runs of a
+// row). `passes` picks MARK_PASS
+// and/or APPLY_PASS; decayFire is one per-cell pass and runs with the mark. The
+// always-on neighbour rules run as their SIMD versions (vectorised<>, simd_react.h)
+// at the width g_step uses; the rest are the scalar functions of materials.h.
+//
+// `a` and `b` are the pass's trigger: a cell's mark can only do anything (change a
+// cell, or a neighbour's apply) when its 3x3 neighbourhood holds one of `a` and, if
+// `b` is not empty, one of `b`. `makes` is every material the apply can write. The
+// fused reaction sweep (see react()) uses them to skip the rows that cannot react.
+// `sites`, if set, are the materials every cell the pass can change touches -- an
+// emitter, or the front of a wave (a virus, a burning fuse, a charge about to blow):
+// the pass then runs only around the cells of those materials (see sites).
+using ReactFn = void (*)(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes);
+template <void (*F)(uint8_t*, uint8_t*, int, int, int, int, int, int)>
+static void untimed(uint8_t* g, uint8_t* s, int SW, int X0, int X1, int Y0, int Y1, uint32_t, int passes) { F(g, s, SW, X0, X1, Y0, Y1, passes); }
+template <int R>
+static void vectorised(uint8_t* g, uint8_t* s, int SW, int X0, int X1, int Y0, int Y1, uint32_t f, int passes) {
+    g_react(R, g, s, SW, X0, X1, Y0, Y1, f, passes);
+}
+static void decay(uint8_t* g, uint8_t*, int SW, int X0, int X1, int Y0, int Y1, uint32_t f, int passes) {
+    if (passes & MARK_PASS) decayFire(g, SW, X0, X1, Y0, Y1, f);
+}
+static constexpr MatMask kHot{FIRE, LAVA};
+static constexpr MatMask anyMaterial() {
+    MatMask m;
+    for (int i = 0; i < MATERIAL_COUNT; ++i) m.add(i);
+    return m;
+}
+static constexpr MatMask kAnyMat = anyMaterial();   // cloner and conveyor write what they carry
+struct Reaction { ReactFn run; MatMask gate; int reach; MatMask a, b, makes, sites; };
+static constexpr MatMask gateOf(int type) {
+    MatMask m;
+    if (const ReactionGate* g = reactionGate(type))
+        for (uint8_t v : g->gate) if (v != EMPTY) m.add(v);
+    return m;
+}
+// An always-on neighbour rule: its row of kReactionRules (reaction_rules.h) is the
+// GPU pass, the trigger and what the apply writes.
+template <int R>
+static constexpr Reaction tableReaction() {
+    constexpr RuleTrigger t = ruleTrigger(kReactionRules[R]);
+    return {vectorised<R>, gateOf(kReactionRules[R].type), 1, t.a, t.b, t.makes, {}};
+}
+static const Reaction kReactions[] = {
+    {decay, gateOf(3), 0, {FIRE, SMOKE, STEAM, ACID}, {}, {SMOKE, ASH, EMPTY, WATER}},
+    tableReaction<SR_IGNITE>(),
+    tableReaction<SR_QUENCH>(),
+    tableReaction<SR_GROW_PLANT>(),
+    tableReaction<SR_DISSOLVE_ACID>(),
+    tableReaction<SR_MAKE_GLASS>(),
+    tableReaction<SR_MELT_ICE>(),
+    tableReaction<SR_FREEZE_WATER>(),
+    {emitSpring, gateOf(18), 1, {SPRING}, {EMPTY}, {WATER}, {SPRING}},
+    {untimed<detonateTnt>, gateOf(20), 2, kHot, {TNT, GUNPOWDER, NITRO}, {FIRE}, {TNT, GUNPOWDER, NITRO}},
+    {emitVolcano, gateOf(22), 1, {VOLCANO}, {EMPTY}, {LAVA}, {VOLCANO}},
+    {untimed<consumeVoid>, gateOf(24), 1, {VOID}, {}, {EMPTY}},
+    tableReaction<SR_MUD_CYCLE>(),   // sand is pervasive: always on
+    {spreadVirus, gateOf(28), 1, {VIRUS}, {}, {VIRUS, EMPTY}, {VIRUS}},
+    {untimed<arcSpark>, gateOf(30), 1, {SPARK}, {}, {SPARK, STEAM, EMPTY, FIRE}},
+    {saltCycle, gateOf(32), 1, {SALT}, {WATER, ICE}, {EMPTY, WATER}},
+    {poisonMercury, gateOf(34), 1, {MERCURY}, {PLANT}, {EMPTY}},
+    {untimed<burnThermite>, gateOf(36), 2, kHot, {THERMITE}, {FIRE, LAVA}, {THERMITE}},
+    {untimed<spreadFrost>, gateOf(38), 1, {FROST}, {}, {FROST, ICE, EMPTY, WATER}, {FROST}},
+    {smoulderCoal, gateOf(40), 2, {FIRE, LAVA, EMBER}, {COAL, EMBER}, {EMBER, ASH, FIRE}},
+    {untimed<cloneMaterial>, gateOf(42), 2, {CLONER}, {}, kAnyMat, {CLONER}},
+    {growCrystal, gateOf(44), 1, {CRYSTAL}, {EMPTY}, {CRYSTAL}},
+    {untimed<annihilate>, gateOf(46), 2, {ANTIMATTER}, {}, {FIRE, EMPTY}},
+    {growMoss, gateOf(48), 1, {MOSS}, {WALL, OBSIDIAN, GLASS, WOOD}, {MOSS}},
+    {vectorised<SR_WIREWORLD>, gateOf(50), 1, {EHEAD, ETAIL}, {}, {EHEAD, ETAIL, WIRE}, {EHEAD, ETAIL}},
+    {untimed<fireIgniter>, gateOf(52), 2, {IGNITER}, {EHEAD}, {FIRE}, {IGNITER}},
+    {untimed<senseWorld>, gateOf(54), 2, {SENSOR}, {}, {EHEAD}},
+    {vectorised<SR_LIFE>, gateOf(56), 1, {LIFE}, {}, {LIFE, EMPTY}},
+    {eruptGeyser, gateOf(58), 1, {GEYSER}, {EMPTY}, {STEAM}, {GEYSER}},
+    {untimed<neutraliseLye>, gateOf(60), 1, {LYE}, {ACID}, {SALT, WATER}},
+    {untimed<reactSodium>, gateOf(62), 2, {SODIUM}, {WATER, FIRE, LAVA}, {FIRE, STEAM}},
+    {growCoral, gateOf(64), 1, {CORAL}, {WATER, FIRE, LAVA}, {CORAL, ASH}},
+    {ignitePhosphorus, gateOf(66), 1, {PHOSPHORUS}, {FIRE, LAVA, EMPTY}, {FIRE}},
+    {hardenCement, gateOf(68), 1, {CEMENT}, {}, {WALL}},
+    {reactChlorine, gateOf(70), 1, {CHLORINE}, {}, {SALT, EMPTY}},
+    {emitBattery, gateOf(72), 1, {BATTERY}, {WIRE}, {EHEAD}, {BATTERY}},
+    {untimed<burnFuse>, gateOf(74), 1, {FIRE, LAVA, EMBER, BURNFUSE}, {FUSE, BURNFUSE}, {BURNFUSE, FIRE}, {FUSE, BURNFUSE}},
+    {reactCryo, gateOf(76), 1, {CRYO}, {}, {ICE, EMPTY, OBSIDIAN}},
+    {untimed<lampLogic>, gateOf(78), 1, {LAMPLIT, EHEAD, ETAIL}, {LAMP, LAMPLIT}, {LAMPLIT, LAMP}},
+    {untimed<petrify>, gateOf(80), 1, {PETRIFY}, {}, {PETRIFY, OBSIDIAN}},
+    {launchFirework, gateOf(82), 2, {FIREWORK}, {}, {FIRE, EMPTY, FIREWORK}},
+    {growTree, gateOf(84), 2, {SPROUT}, {}, {PLANT, WOOD, SPROUT}},
+    {untimed<runConveyor>, gateOf(86), 1, {BELT}, {}, kAnyMat},
+    {untimed<magnetise>, gateOf(88), 1, {MAGNET}, {IRON}, {MAGNET}},
+    {rustCycle, gateOf(90), 1, {IRON, RUST}, {WATER, ACID, FIRE, LAVA}, {RUST, IRON}},
+    {germinateSeed, gateOf(92), 1, {SEED}, {WATER}, {SPROUT}},
+    {untimed<laserBeam>, gateOf(94), 2, {LASER, BEAM}, {}, {BEAM, EMPTY, FIRE}},
+    {growIcicle, gateOf(96), 2, {ICICLE}, {}, {ICE, ICICLE}},
+};
+// The materials some reaction starts from: while none is resident no pass can fire.
+static constexpr MatMask kReactive{FIRE, LAVA, STEAM, PLANT, ACID, SMOKE, ICE, SPRING, VOLCANO, VOID,
+                                   WATER, VIRUS, SPARK, SALT, FROST, EMBER, CLONER, CRYSTAL, ANTIMATTER, MOSS,
+                                   EHEAD, ETAIL, SENSOR, LIFE, GEYSER, PHOSPHORUS, CEMENT, CHLORINE, BATTERY, BURNFUSE,
+                                   CRYO, LAMPLIT, PETRIFY, FIREWORK, SPROUT, BELT, MAGNET, LASER, BEAM, ICICLE};
+// Every Reaction::sites material, and those of them that move: a frame's movement
+// may carry one MOVE_REACH cells from where the last frame left it.
+static constexpr MatMask kSites{SPRING, VOLCANO, CLONER, IGNITER, GEYSER, BATTERY, TNT, GUNPOWDER, NITRO,
+                                VIRUS, THERMITE, FROST, FUSE, BURNFUSE, EHEAD, ETAIL};
+static constexpr MatMask kDriftingSites{GUNPOWDER, NITRO, THERMITE};
+// The movement step's reach: each of its 16 sub-passes moves a cell one row/column.
+static constexpr int MOVE_REACH = 16;
+
+// SANDSIM_SCHED=bands runs a threaded step as row bands with a barrier per pass
+// instead of the (chunk, pass) task graph. Same result; kept for comparison.
+static bool bandSched() {
+    const char* e = std::getenv("SANDSIM_SCHED");
+    return e && std::strcmp(e, "bands") == 0;
+}
+
+// SANDSIM_REACT=passes runs every reaction pass as a full sweep of its own instead of
+// the fused, trigger-gated sweep. Same result; kept for comparison.
+static bool fusedReactions() {
+    const char* e = std::getenv("SANDSIM_REACT");
+    return !(e && std::strcmp(e, "passes") == 0);
+}
+
+// SANDSIM_KERNEL=generic runs the movement classifier over every table bank rather
+// than just the ones the window's materials need. Same result; kept for comparison.
+static bool specialisedMove() {
+    const char* e = std::getenv("SANDSIM_KERNEL");
+    return !(e && std::strcmp(e, "generic") == 0);
+}
+
+// SANDSIM_SITES=off runs every site pass (Reaction::sites) as a sweep of the whole
+// rectangle rather than around its listed sites. Same result; kept to check the site
+// lists against the full scan.
+static bool siteLists() {
+    const char* e = std::getenv("SANDSIM_SITES");
+    return !(e && std::strcmp(e, "off") == 0);
+}
+
+// SANDSIM_SLEEP=off steps every resident chunk every frame. Same result; kept to
+// check the sleeping-chunk bookkeeping against the plain full-window step.
+static bool sleepChunks() {
+    const char* e = std::getenv("SANDSIM_SLEEP");
+    return !(e && std::strcmp(e, "off") == 0);
+}
+
+// GridLayout::Tiles runs a threaded task frame on one contiguous tile per chunk
+// instead of the row-major grid (see stepTasks()). Same result, at the cost of a copy
+// in and out each frame, and not yet timed on more than one core: only a SimdWorld
+// constructed with it (or `--bench ... tiles`) uses it.
+enum class GridLayout { Rows, Tiles };
 
 class SimdWorld {
 public:
     // gw x gh chunks resident (the live window); the world is wbox x hbox chunks.
-    SimdWorld(int gw, int gh, int wbox, int hbox, std::string dir)
-        : gw(gw), gh(gh), LW(gw * CHUNK), LH(gh * CHUNK), SW(LW + 2 * PAD), SH(LH + 2 * PAD),
+    SimdWorld(int gw, int gh, int wbox, int hbox, std::string dir, GridLayout layout = GridLayout::Rows)
+        : gw(gw), gh(gh), LW(gw * CHUNK), LH(gh * CHUNK), SW(gridStride(LW, PAD)), SH(LH + 2 * PAD),
           X0(PAD), X1(PAD + LW), Y0(PAD), Y1(PAD + LH),
-          wbox(wbox), hbox(hbox), dir(std::move(dir)) {
+          wbox(wbox), hbox(hbox), dir(std::move(dir)), layout(layout) {
         std::filesystem::create_directories(this->dir);
-        grid.assign((size_t)SW * SH, WALL);     // everything starts solid (border stays WALL)
-        moved.assign((size_t)SW * SH, 0);
+        grid.assign((size_t)SW * SH, WALL, X0);     // everything starts solid (border stays WALL)
+        moved.assign(movedBytes(SW, SH), 0, X0);
+        scratch.assign((size_t)SW * SH, 0, X0);
+        prev.assign((size_t)SW * SH, WALL, X0);
+        dirty.assign((size_t)gw * gh, Rect{});
+        resident.assign((size_t)gw * gh, MatMask{});
+        chunkPop.assign((size_t)gw * gh * MATERIAL_COUNT, 0);
+        chunkSites.resize((size_t)gw * gh);
+        memberSpans.resize((size_t)pool.size());
+        awake.assign((size_t)gw * gh, 1);
+        period.assign((size_t)gw * gh, 1);
+        since.assign((size_t)gw * gh, 0);
+        parked.assign((size_t)gw * gh, 0);
+        timed.assign((size_t)gw * gh, 1);
+        cycle.resize((size_t)gw * gh);
+        hist.assign((size_t)gw * gh * HIST, 0);
+        histLen.assign((size_t)gw * gh, 0);
+        bandSkipped.assign((size_t)pool.size(), 0);
+        if (layout == GridLayout::Tiles) {
+            tileGrid.assign((size_t)gw * gh * TILE_BYTES, WALL, PAD);
+            tileScratch.assign((size_t)gw * gh * TILE_BYTES, 0, PAD);
+            tileMoved.assign((size_t)gw * gh * TILE_MOVED_BYTES, 0, PAD);
+        }
+        chunkSpans.resize((size_t)gw * gh * spanSumCount(0, CHUNK, 0, CHUNK));
+        memberBlocks.assign((size_t)pool.size() * memberBlockBytes(), 0);
     }
 
     int winChunksW() const { return gw; }
@@ -113,72 +316,57 @@ public:
             }
         winCx = camCx; winCy = camCy; windowValid = true;
         residentMax = gw * gh;
+        wakeAll = true;
     }
 
-    void step() {
-        g_step(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);
-        if (hasReactive) {                                              // moved = scratch buffer
-            decayFire(grid.data(), SW, X0, X1, Y0, Y1, frame);
-            igniteFire(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);
-            quench(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);
-            growPlant(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);
-            dissolveAcid(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);
-            makeGlass(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);
-            meltIce(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);
-            freezeWater(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);
-            if (present[SPRING])   emitSpring(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);
-            if (present[TNT] || present[GUNPOWDER] || present[NITRO]) detonateTnt(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);
-            if (present[VOLCANO])  emitVolcano(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);  // pass 22/23
-            if (present[VOID])     consumeVoid(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);         // pass 24/25
-            mudCycle(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);     // pass 26/27 (sand pervasive: always on)
-            if (present[VIRUS])    spreadVirus(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);  // pass 28/29
-            if (present[SPARK])    arcSpark(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);            // pass 30/31
-            if (present[SALT] || present[LYE] || present[CHLORINE]) saltCycle(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame); // pass 32/33 (LYE/CHLORINE make SALT)
-            if (present[MERCURY])  poisonMercury(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame); // pass 34/35
-            if (present[THERMITE]) burnThermite(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);        // pass 36/37
-            if (present[FROST])    spreadFrost(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);         // pass 38/39
-            if (present[COAL] || present[EMBER]) smoulderCoal(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame); // pass 40/41
-            if (present[CLONER])   cloneMaterial(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);       // pass 42/43
-            if (present[CRYSTAL])  growCrystal(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);  // pass 44/45
-            if (present[ANTIMATTER]) annihilate(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);        // pass 46/47
-            if (present[MOSS])     growMoss(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);     // pass 48/49
-            if (present[EHEAD] || present[ETAIL] || present[SENSOR] || present[BATTERY]) wireWorld(grid.data(), moved.data(), SW, X0, X1, Y0, Y1); // pass 50/51 (SENSOR/BATTERY can create electrons)
-            if (present[IGNITER])  fireIgniter(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);         // pass 52/53
-            if (present[SENSOR])   senseWorld(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);          // pass 54/55
-            if (present[LIFE])     conwayLife(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);          // pass 56/57
-            if (present[GEYSER])   eruptGeyser(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);  // pass 58/59
-            if (present[LYE])      neutraliseLye(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);       // pass 60/61
-            if (present[SODIUM])   reactSodium(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);         // pass 62/63
-            if (present[CORAL])    growCoral(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);    // pass 64/65
-            if (present[PHOSPHORUS]) ignitePhosphorus(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame); // pass 66/67
-            if (present[CEMENT])   hardenCement(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);     // pass 68/69
-            if (present[CHLORINE]) reactChlorine(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);    // pass 70/71
-            if (present[BATTERY])  emitBattery(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);      // pass 72/73
-            if (present[FUSE] || present[BURNFUSE]) burnFuse(grid.data(), moved.data(), SW, X0, X1, Y0, Y1); // pass 74/75
-            if (present[CRYO])     reactCryo(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);        // pass 76/77
-            if (present[LAMP] || present[LAMPLIT]) lampLogic(grid.data(), moved.data(), SW, X0, X1, Y0, Y1); // pass 78/79
-            if (present[PETRIFY])  petrify(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);                 // pass 80/81
-            if (present[FIREWORK]) launchFirework(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);   // pass 82/83
-            if (present[SPROUT] || present[SEED]) growTree(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame); // pass 84/85 (SEED germinates into SPROUT)
-            if (present[BELT])     runConveyor(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);             // pass 86/87
-            if (present[MAGNET])   magnetise(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);               // pass 88/89
-            if (present[IRON] || present[RUST]) rustCycle(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame); // pass 90/91
-            if (present[SEED])     germinateSeed(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);     // pass 92/93
-            if (present[LASER] || present[BEAM]) laserBeam(grid.data(), moved.data(), SW, X0, X1, Y0, Y1);  // pass 94/95
-            if (present[ICICLE])   growIcicle(grid.data(), moved.data(), SW, X0, X1, Y0, Y1, frame);        // pass 96/97
+    // `frames` frames: more than one as one temporal step (stepAhead()), which neither
+    // sleeps nor parks; one as a frame of its own.
+    void step(int frames = 1) {
+        if (frames > 1) stepAhead(frames);
+        else stepFrame();
+    }
+    void stepFrame() {
+        livePasses();
+        int reach = MOVE_REACH;                         // how far one frame can carry a change
+        if (hasReactive)
+            for (const Reaction& r : kReactions) if (runs(r)) reach += r.reach;
+        if (sleep) parkChunks(reach);
+        std::vector<Rect> rects = wakeRects(reach);
+        if (hasReactive) gatherSites();
+        if (hasReactive && pool.size() > 1 && !bandSched()) gateChunks();
+        for (const Rect& r : rects)                     // snapshot each rect and its 1-cell ring
+            std::memcpy(&prev[(size_t)(r.y0 - 1) * SW], &grid[(size_t)(r.y0 - 1) * SW], (size_t)(r.y1 - r.y0 + 2) * SW);
+        for (const Rect& r : rects) {
+            blocksTotal += 14ull * (r.y1 - r.y0) * ((r.x1 - r.x0 + simdWidth() - 1) / simdWidth());   // 16 sub-passes = 14 full sweeps
+            if (pool.size() > 1) { if (bandSched()) stepBanded(r); else stepTasks(r); continue; }
+            blocksSkipped += g_step(grid.data(), moved.data(), SW, r.x0, r.x1, r.y0, r.y1, frame, moveMats());
+            if (!hasReactive) continue;                 // byte-per-cell mark buffer
+            if (fuseReact) { react(r); continue; }
+            for (int i = 0; i < (int)(sizeof(kReactions) / sizeof(kReactions[0])); ++i) {
+                const Reaction& rx = kReactions[i];
+                if (!runs(rx)) continue;
+                if (!sparse[i]) { rx.run(grid.data(), scratch.data(), SW, r.x0, r.x1, r.y0, r.y1, frame, BOTH_PASSES); continue; }
+                runSites(i, r.x0, r.x1, r.y0, r.y1, MARK_PASS, memberSpans[0]);
+                runSites(i, r.x0, r.x1, r.y0, r.y1, APPLY_PASS, memberSpans[0]);
+            }
         }
+        for (const Rect& r : rects) restoreSleeping(r);
+        settle(sleep);
         ++frame;
     }
 
     void paint(int lx, int ly, uint8_t material, int radius) {
-        if (material == FIRE || material == LAVA || material == STEAM || material == PLANT || material == ACID || material == SMOKE || material == ICE || material == SPRING || material == VOLCANO || material == VOID || material == WATER || material == VIRUS || material == SPARK || material == SALT || material == FROST || material == EMBER || material == CLONER || material == CRYSTAL || material == ANTIMATTER || material == MOSS || material == EHEAD || material == ETAIL || material == SENSOR || material == LIFE || material == GEYSER || material == PHOSPHORUS || material == CEMENT || material == CHLORINE || material == BATTERY || material == BURNFUSE || material == CRYO || material == LAMPLIT || material == PETRIFY || material == FIREWORK || material == SPROUT || material == BELT || material == MAGNET || material == LASER || material == BEAM || material == ICICLE) hasReactive = true;
-        present[material] = true;
+        const bool wasReactive = hasReactive, wasPresent = present.has(material);
         for (int dy = -radius; dy <= radius; ++dy)
             for (int dx = -radius; dx <= radius; ++dx) {
                 int nx = lx + dx, ny = ly + dy;
-                if (nx >= 0 && nx < LW && ny >= 0 && ny < LH && dx * dx + dy * dy <= radius * radius)
-                    grid[(size_t)(ny + Y0) * SW + (nx + X0)] = material;
+                if (nx >= 0 && nx < LW && ny >= 0 && ny < LH && dx * dx + dy * dy <= radius * radius) {
+                    put(nx + X0, ny + Y0, material);
+                    touch(nx + X0, ny + Y0);
+                }
             }
+        livePasses();
+        if (hasReactive != wasReactive || !wasPresent) wakeAll = true;   // a new pass may run
     }
     uint8_t viewCell(int lx, int ly) const { return grid[(size_t)(ly + Y0) * SW + (lx + X0)]; }
 
@@ -187,21 +375,28 @@ public:
         for (int y = Y0; y < Y1; ++y)
             for (int x = X0; x < X1; ++x)
                 grid[(size_t)y * SW + x] = EMPTY;
+        std::fill(chunkPop.begin(), chunkPop.end(), 0);
+        std::fill(population, population + MATERIAL_COUNT, 0);
+        for (size_t c = 0; c < (size_t)gw * gh; ++c) chunkPop[c * MATERIAL_COUNT + EMPTY] = CHUNK * CHUNK;
+        population[EMPTY] = (uint32_t)gw * gh * CHUNK * CHUNK;
+        std::fill(resident.begin(), resident.end(), MatMask{EMPTY});
+        for (std::vector<Site>& v : chunkSites) v.clear();
+        livePasses();
+        wakeAll = true;
     }
 
     // Clear the resident area and stamp a w*h scene at viewport-local (atX,atY) -- used to
-    // load a challenge layout in one shot. Marks the materials present so reactions run.
+    // load a challenge layout in one shot.
     void loadView(const uint8_t* cells, int w, int h, int atX, int atY) {
         clearView();
         for (int y = 0; y < h; ++y)
             for (int x = 0; x < w; ++x) {
                 int lx = atX + x, ly = atY + y;
                 if (lx < 0 || lx >= LW || ly < 0 || ly >= LH) continue;
-                uint8_t m = cells[(size_t)y * w + x];
-                grid[(size_t)(ly + Y0) * SW + (lx + X0)] = m;
-                if (m) present[m] = true;
+                put(lx + X0, ly + Y0, cells[(size_t)y * w + x]);
             }
-        hasReactive = true;
+        livePasses();
+        wakeAll = true;
     }
 
     void summary(uint64_t& checksum, uint64_t counts[MATERIAL_COUNT]) {
@@ -222,43 +417,976 @@ public:
     int residentMaxCount() const { return residentMax; }
     long long diskWrites() const { return nWrites; }
     long long diskReads() const { return nReads; }
+    unsigned long long movementBlocks() const { return blocksTotal; }
+    unsigned long long movementBlocksSkipped() const { return blocksSkipped; }
+    double awakeShare() const { return chunkFrames ? (double)awakeFrames / chunkFrames : 0.0; }
+    double parkedShare() const { return chunkFrames ? (double)parkedFrames / chunkFrames : 0.0; }
+    unsigned long long temporalTiles() const { return aheadTiles; }
+    double siteShare() const { return sitePassFrames ? (double)sparseFrames / sitePassFrames : 0.0; }
 
 private:
     const int gw, gh;                 // live window in chunks
     const int LW, LH;                 // live window in cells
-    const int SW, SH;                 // padded stride / height
+    const int SW, SH;                 // padded stride (a whole number of cache lines) / height
     const int X0, X1, Y0, Y1;         // interior cell range
     int wbox, hbox;
     std::string dir;
-    std::vector<uint8_t> grid;   // padded contiguous live region
-    std::vector<uint8_t> moved;
+    GridBuffer grid;   // padded contiguous live region
+    GridBuffer moved;     // movement's moved-this-frame bit plane (see world_step.h)
+    GridBuffer scratch;   // reactions' mark/apply buffer, one byte per cell
     int winCx = 0, winCy = 0;
     bool windowValid = false;
     uint32_t frame = 0;
     int residentMax = 0;
     long long nWrites = 0, nReads = 0;
-    bool hasReactive = false;      // gates the reaction passes; set when any reactive material enters the grid
-    // Per-material "has this ever been resident?" latch. A reaction whose trigger material is
-    // neither loaded, painted, nor *created by another reaction* (so its only source is itself
-    // or nothing) is a guaranteed no-op while its flag is false, so it can be skipped -- this
-    // is the perf gate for the many paint-only reactions (virus, frost, crystal, ...). Set, never
-    // cleared: a stale flag only costs an extra (still no-op) pass, never a wrong result.
-    bool present[MATERIAL_COUNT] = {false};
+    unsigned long long blocksTotal = 0, blocksSkipped = 0;   // movement blocks visited / skipped as inert
+
+    // --- live population -----------------------------------------------------
+    // How many cells of each material the window holds, exactly: per chunk and in
+    // total. Loading a chunk, painting and loading a view update the counts as they
+    // write; a step only changes awake chunks, which settle() recounts as it reads
+    // them for their resident materials. A reaction's gate lists its trigger and every
+    // material another pass can make it from, so while none of them is resident at
+    // the start of a frame it is a no-op and is skipped -- and it stops running again
+    // once the last VIRUS or SPARK dies out.
+    std::vector<uint16_t> chunkPop;   // per chunk, per material: cells
+    uint32_t population[MATERIAL_COUNT] = {};
+    MatMask present;                  // materials with a nonzero population
+    bool hasReactive = false;         // one of kReactive is present: the reactions run
+    bool runs(const Reaction& r) const { return r.gate.empty() || present.meets(r.gate); }
+    const bool specialise = specialisedMove();
+    const uint64_t* moveMats() const { return specialise ? present.w : nullptr; }   // see simdStepBanks()
+
+    void livePasses() {
+        present = MatMask{};
+        for (int m = 0; m < MATERIAL_COUNT; ++m)
+            if (population[m]) present.add(m);
+        hasReactive = present.meets(kReactive);
+    }
+    size_t chunkOf(int x, int y) const { return (size_t)((y - Y0) / CHUNK) * gw + (x - X0) / CHUNK; }
+    void put(int x, int y, uint8_t v) {               // write one cell, keeping the counts
+        uint8_t& g = grid[(size_t)y * SW + x];
+        if (g == v) return;
+        const size_t c = chunkOf(x, y);
+        uint16_t* n = &chunkPop[c * MATERIAL_COUNT];
+        --n[g]; --population[g];
+        ++n[v]; ++population[v];
+        resident[c].add(v);                           // settle() drops what went
+        if (kSites.has(g) || kSites.has(v)) editSite(c, y, x, v);
+        g = v;
+        disturb(c);
+    }
+    // Recount chunk c from the grid; returns the materials in it.
+    MatMask countChunk(size_t c) {
+        uint16_t n[MATERIAL_COUNT] = {};
+        const Rect r = chunkRect((int)(c % gw), (int)(c / gw));
+        for (int y = r.y0; y < r.y1; ++y) {
+            const uint8_t* g = &grid[(size_t)y * SW];
+            for (int x = r.x0; x < r.x1; ++x) ++n[g[x]];
+        }
+        uint16_t* old = &chunkPop[c * MATERIAL_COUNT];
+        MatMask m;
+        for (int i = 0; i < MATERIAL_COUNT; ++i) {
+            population[i] += n[i] - old[i];
+            old[i] = n[i];
+            if (n[i]) m.add(i);
+        }
+        return m;
+    }
+
+    // --- sites: emitters and wave fronts --------------------------------------
+    // A site pass (Reaction::sites) can only change cells next to a cell of its site
+    // materials: an emitter (spring, volcano, cloner, igniter, geyser, battery) or the
+    // front of a wave (virus, frost, a lit fuse, thermite and the explosives waiting
+    // for heat, the electrons on a wire). It runs on the cells around the sites rather than sweeping its
+    // rectangle: its marks within its reach of one (the cells its applies read), its
+    // applies next to one -- both widened by MOVE_REACH around a site that moves.
+    //
+    // Each chunk lists its site cells, sorted. Loading a chunk scans it; painting
+    // edits the list; settle() rescans only the columns of each row the frame changed,
+    // so a front costs its length, not the area behind it. At the start of a frame each
+    // running site pass gathers its sites sorted by row. It sweeps as before if a pass
+    // before it may make one of its sites this frame (a CLONER copying an emitter), or
+    // if its sites are so many that their neighbourhoods would cover much of the window.
+    struct Site {
+        int y, x; uint8_t m;
+        bool operator<(const Site& o) const { return y != o.y ? y < o.y : x < o.x; }
+    };
+    using Span = std::pair<int, int>;
+    std::vector<std::vector<Site>> chunkSites;   // per chunk: its site cells, by row
+    std::vector<Site> siteTmp;                   // updateSites()
+    std::vector<Span> changedCols;               // per row of a chunk: what settle() saw change
+    std::vector<std::vector<Site>> passSites;    // per reaction: this frame's sites
+    std::vector<uint8_t> sparse;                 // per reaction: runs on passSites this frame
+    std::vector<int> siteDrift;                  // per reaction: how far its sites may have moved
+    std::vector<std::vector<Span>> memberSpans;  // per team member: siteSpans() output
+    const bool useSites = siteLists();
+    unsigned long long sitePassFrames = 0, sparseFrames = 0;   // site passes run / run on their sites
+
+    bool holdsSites(size_t c) const {
+        const uint16_t* n = &chunkPop[c * MATERIAL_COUNT];
+        for (int m = 0; m < MATERIAL_COUNT; ++m)
+            if (n[m] && kSites.has(m)) return true;
+        return false;
+    }
+    // Chunk c's list, with columns cols[y - top] of each row read from the grid and the
+    // rest of the row kept.
+    void updateSites(size_t c, const Span* cols) {
+        std::vector<Site>& v = chunkSites[c];
+        if (!holdsSites(c)) { v.clear(); return; }
+        const Rect r = chunkRect((int)(c % gw), (int)(c / gw));
+        siteTmp.clear();
+        size_t k = 0;
+        for (int y = r.y0; y < r.y1; ++y) {
+            const Span cs = cols[y - r.y0];
+            for (; k < v.size() && v[k].y == y && v[k].x < cs.first; ++k) siteTmp.push_back(v[k]);
+            const uint8_t* g = &grid[(size_t)y * SW];
+            for (int x = cs.first; x < cs.second; ++x)
+                if (kSites.has(g[x])) siteTmp.push_back({y, x, g[x]});
+            for (; k < v.size() && v[k].y == y; ++k)
+                if (v[k].x >= cs.second) siteTmp.push_back(v[k]);
+        }
+        v.swap(siteTmp);
+    }
+    void listSites(size_t c) {
+        const Rect r = chunkRect((int)(c % gw), (int)(c / gw));
+        changedCols.assign(CHUNK, Span{r.x0, r.x1});
+        chunkSites[c].clear();
+        updateSites(c, changedCols.data());
+    }
+    void editSite(size_t c, int y, int x, uint8_t v) {   // cell (x, y) of chunk c became v
+        std::vector<Site>& l = chunkSites[c];
+        auto it = std::lower_bound(l.begin(), l.end(), Site{y, x, 0});
+        const bool listed = it != l.end() && it->y == y && it->x == x;
+        if (!kSites.has(v)) { if (listed) l.erase(it); }
+        else if (listed) it->m = v;
+        else l.insert(it, {y, x, v});
+    }
+    void gatherSites() {
+        const int nr = (int)(sizeof(kReactions) / sizeof(kReactions[0]));
+        const long long area = (long long)gw * gh * CHUNK * CHUNK;
+        sparse.assign(nr, 0);
+        siteDrift.assign(nr, 0);
+        passSites.resize(nr);
+        MatMask made;                                 // what the passes so far may write
+        for (int i = 0; i < nr; ++i) {
+            const Reaction& rx = kReactions[i];
+            if (!runs(rx)) continue;
+            sitePassFrames += !rx.sites.empty();
+            if (useSites && !rx.sites.empty() && !made.meets(rx.sites)) {
+                std::vector<Site>& v = passSites[i];
+                v.clear();
+                for (const std::vector<Site>& cs : chunkSites)
+                    for (const Site& st : cs) if (rx.sites.has(st.m)) v.push_back(st);
+                std::sort(v.begin(), v.end());
+                siteDrift[i] = rx.sites.meets(kDriftingSites) ? MOVE_REACH : 0;
+                const long long side = 2 * (rx.reach + siteDrift[i]) + 1;
+                sparse[i] = (long long)v.size() * side * side * 4 < area;
+                sparseFrames += sparse[i];
+            }
+            made |= rx.makes;
+        }
+    }
+    // How far around its sites pass i marks or applies.
+    int siteReach(int i, bool apply) const { return (apply ? 1 : kReactions[i].reach) + siteDrift[i]; }
+    // The merged column spans of row y within `reach` of sites v (by row), in [x0, x1).
+    static void siteSpans(const std::vector<Site>& v, int y, int reach, int x0, int x1, std::vector<Span>& out) {
+        out.clear();
+        for (auto it = std::lower_bound(v.begin(), v.end(), Site{y - reach, 0, 0}); it != v.end() && it->y <= y + reach; ++it) {
+            const int a = std::max(x0, it->x - reach), b = std::min(x1, it->x + reach + 1);
+            if (a < b) out.push_back({a, b});
+        }
+        std::sort(out.begin(), out.end());
+        size_t k = 0;
+        for (const Span& sp : out) {
+            if (k && sp.first <= out[k - 1].second) out[k - 1].second = std::max(out[k - 1].second, sp.second);
+            else out[k++] = sp;
+        }
+        out.resize(k);
+    }
+    // Site pass i's MARK_PASS or APPLY_PASS over [x0, x1) x [y0, y1), on the live grid
+    // or on a chunk's tile (g, s, S: see tileCells()).
+    void runSites(int i, int x0, int x1, int y0, int y1, int pass, std::vector<Span>& spans,
+                  uint8_t* g = nullptr, uint8_t* s = nullptr, int S = 0) {
+        if (!g) { g = grid.data(); s = scratch.data(); S = SW; }
+        const Reaction& rx = kReactions[i];
+        for (int y = y0; y < y1; ++y) {
+            siteSpans(passSites[i], y, siteReach(i, pass == APPLY_PASS), x0, x1, spans);
+            for (const Span& sp : spans) rx.run(g, s, S, sp.first, sp.second, y, y + 1, frame, pass);
+        }
+    }
+
+    // --- sleeping chunks -----------------------------------------------------
+    // Noita-style dirty rects, kept exact. Each chunk records the grid cells that
+    // changed last frame (its dirty rect), or its whole area while a frame-dependent
+    // rule may fire in or next to it (kTimedRules). The frame is otherwise a pure
+    // function of the grid, and one frame carries a change at most `reach` cells (the
+    // sum of every running pass's reach), so a chunk with no dirty rect within `reach`
+    // cannot change: it sleeps. The awake chunks are stepped as a few rectangles grown
+    // by reach+1 -- every awake cell then sees exactly the neighbourhood the full step
+    // would -- and whatever those rectangles wrote into sleeping chunks (the margin,
+    // stepped without its own surroundings) is put back from the snapshot.
+    struct Rect { int x0 = 0, y0 = 0, x1 = 0, y1 = 0; bool empty() const { return x0 >= x1 || y0 >= y1; } };
+    std::vector<Rect> dirty;          // per chunk: grid cells that changed last frame
+    std::vector<MatMask> resident;    // per chunk: materials in it after last frame (and painted since)
+    std::vector<uint8_t> awake;       // per chunk: stepped this frame
+    GridBuffer prev;                  // grid rows of this frame's rectangles, before the step
+    bool wakeAll = true;              // the grid or the pass set changed outside a step
+    const bool sleep = sleepChunks();
+    unsigned long long chunkFrames = 0, awakeFrames = 0;
+
+    Rect chunkRect(int cx, int cy) const {
+        return {X0 + cx * CHUNK, Y0 + cy * CHUNK, X0 + (cx + 1) * CHUNK, Y0 + (cy + 1) * CHUNK};
+    }
+    void touch(int x, int y) {                          // a cell changed between frames
+        Rect& d = dirty[(size_t)((y - Y0) / CHUNK) * gw + (x - X0) / CHUNK];
+        if (d.empty()) d = {x, y, x + 1, y + 1};
+        else d = {std::min(d.x0, x), std::min(d.y0, y), std::max(d.x1, x + 1), std::max(d.y1, y + 1)};
+    }
+
+    // Wake every chunk within `reach` of a dirty rect, and cover the awake chunks with
+    // chunk-aligned rectangles grown by reach+1 (one per chunk row, merged while they
+    // come within a cell of each other, so no rectangle reads what another writes).
+    std::vector<Rect> wakeRects(int reach) {
+        for (int c = 0; c < gw * gh; ++c) awake[c] = wakeAll || !sleep;
+        wakeAll = false;
+        for (const Rect& d : dirty) {
+            if (d.empty()) continue;
+            int cx0 = std::max(0, (d.x0 - reach - X0) / CHUNK), cx1 = std::min(gw - 1, (d.x1 - 1 + reach - X0) / CHUNK);
+            int cy0 = std::max(0, (d.y0 - reach - Y0) / CHUNK), cy1 = std::min(gh - 1, (d.y1 - 1 + reach - Y0) / CHUNK);
+            for (int cy = cy0; cy <= cy1; ++cy)
+                for (int cx = cx0; cx <= cx1; ++cx) awake[(size_t)cy * gw + cx] = 1;
+        }
+        for (int c = 0; c < gw * gh; ++c)
+            if (parked[c] && awake[c]) { awake[c] = 0; ++parkedFrames; }
+        const int grow = (reach + 1 + CHUNK - 1) / CHUNK;   // margin, in whole chunks
+        std::vector<Rect> rects;
+        for (int cy = 0; cy < gh; ++cy) {
+            int a = gw, b = -1;
+            for (int cx = 0; cx < gw; ++cx)
+                if (awake[(size_t)cy * gw + cx]) { a = std::min(a, cx); b = cx; }
+            if (b < 0) continue;
+            rects.push_back({X0 + std::max(0, a - grow) * CHUNK, Y0 + std::max(0, cy - grow) * CHUNK,
+                             X0 + std::min(gw, b + 1 + grow) * CHUNK, Y0 + std::min(gh, cy + 1 + grow) * CHUNK});
+        }
+        for (bool merged = true; merged;) {
+            merged = false;
+            for (size_t i = 0; i < rects.size() && !merged; ++i)
+                for (size_t j = i + 1; j < rects.size() && !merged; ++j) {
+                    Rect& p = rects[i]; const Rect& q = rects[j];
+                    if (p.x0 > q.x1 + 1 || q.x0 > p.x1 + 1 || p.y0 > q.y1 + 1 || q.y0 > p.y1 + 1) continue;
+                    p = {std::min(p.x0, q.x0), std::min(p.y0, q.y0), std::max(p.x1, q.x1), std::max(p.y1, q.y1)};
+                    rects.erase(rects.begin() + j);
+                    merged = true;
+                }
+        }
+        return rects;
+    }
+
+    // Put back the sleeping cells a rectangle (and its 1-cell ring) may have written.
+    void restoreSleeping(const Rect& r) {
+        for (int cy = 0; cy < gh; ++cy)
+            for (int cx = 0; cx < gw; ++cx) {
+                if (awake[(size_t)cy * gw + cx]) continue;
+                Rect c = chunkRect(cx, cy);
+                int x0 = std::max(c.x0, r.x0 - 1), x1 = std::min(c.x1, r.x1 + 1);
+                int y0 = std::max(c.y0, r.y0 - 1), y1 = std::min(c.y1, r.y1 + 1);
+                for (int y = y0; y < y1 && x0 < x1; ++y)
+                    std::memcpy(&grid[(size_t)y * SW + x0], &prev[(size_t)y * SW + x0], (size_t)(x1 - x0));
+            }
+    }
+
+    // After the step: each awake chunk's dirty rect is what the frame changed in it, its
+    // materials are re-read and its sites re-read where it changed, and each parked
+    // chunk is set to its next recorded state the same way; then every chunk where a
+    // timed rule may fire next frame is dirty as a whole. `tracking` feeds each chunk's
+    // state to parking (off after a temporal step, which is not one frame).
+    void settle(bool tracking) {
+        for (int cy = 0; cy < gh; ++cy)
+            for (int cx = 0; cx < gw; ++cx) {
+                const size_t c = (size_t)cy * gw + cx;
+                dirty[c] = Rect{};
+                const bool replay = parked[c] && period[c] > 1;
+                if (!awake[c] && !replay) { if (tracking) track(c, false); continue; }
+                const Rect r = chunkRect(cx, cy);
+                const uint8_t* next = replay ? &cycle[c][(size_t)((frame + 1) % period[c]) * CHUNK * CHUNK] : nullptr;
+                bool changed = false;
+                changedCols.assign(CHUNK, Span{r.x0, r.x0});
+                for (int y = r.y0; y < r.y1; ++y) {
+                    uint8_t* g = &grid[(size_t)y * SW + r.x0];
+                    const uint8_t* p = replay ? next + (size_t)(y - r.y0) * CHUNK : &prev[(size_t)y * SW + r.x0];
+                    if (std::memcmp(g, p, CHUNK) == 0) continue;
+                    int a = 0, b = CHUNK - 1;
+                    while (g[a] == p[a]) ++a;
+                    while (g[b] == p[b]) --b;
+                    touch(r.x0 + a, y); touch(r.x0 + b, y);
+                    changedCols[y - r.y0] = {r.x0 + a, r.x0 + b + 1};
+                    if (replay) std::memcpy(g, p, CHUNK);
+                    changed = true;
+                }
+                resident[c] = countChunk(c);
+                updateSites(c, changedCols.data());
+                if (tracking) track(c, changed);
+            }
+        for (int cy = 0; cy < gh; ++cy)
+            for (int cx = 0; cx < gw; ++cx) {
+                MatMask near;
+                for (int ny = std::max(0, cy - 1); ny <= std::min(gh - 1, cy + 1); ++ny)
+                    for (int nx = std::max(0, cx - 1); nx <= std::min(gw - 1, cx + 1); ++nx) near |= resident[(size_t)ny * gw + nx];
+                timed[(size_t)cy * gw + cx] = timedRuleMayFire(near);
+                if (timed[(size_t)cy * gw + cx]) dirty[(size_t)cy * gw + cx] = chunkRect(cx, cy);
+            }
+        chunkFrames += (unsigned long long)gw * gh;
+        for (uint8_t a : awake) awakeFrames += a;
+    }
+
+    // --- parked chunks ------------------------------------------------------
+    // Sleeping covers chunks that stopped changing; parking covers the ones that
+    // repeat: a Life blinker, a Wireworld clock, the cells around them. A frame's reach
+    // spans the chunks within k = ceil((reach+1)/CHUNK) of a chunk, and none of them may
+    // have a timed rule that can fire (a product of one can move or react into C), so
+    // C's next state is a pure function of the cells within that reach.
+    // A chunk has a period q (1 unless tracked) and `since`: its state at every frame
+    // f in [since, frame] equals its state at f - q. If every chunk within k of C has
+    // a period dividing p and has repeated since frame - p + q, the neighbourhood is
+    // now what it was p frames ago, so C's next state is the one it had p - 1 frames
+    // ago. C is then parked: not stepped, but set to that state -- a stored one for a
+    // tracked chunk, its own for q = 1 -- and by induction the frame is unchanged.
+    // Parked chunks stay parked while that holds and are stepped again from the frame
+    // a chunk near them does anything else.
+    //
+    // Each chunk hashes its state after each frame it changed. A chunk whose last
+    // 2p hashes repeat with period p (the smallest in 2..PARK_PERIOD) is tracked: its
+    // next p states are recorded, and from then on every state is compared, byte for
+    // byte, with the one p frames before. The hashes only pick candidates; parking
+    // rests on the comparisons. Painting a chunk, loading the window and a change in
+    // the pass set start every chunk involved over.
+    static constexpr int PARK_PERIOD = 16;            // longest cycle looked for, in frames
+    static constexpr int HIST = 2 * PARK_PERIOD;
+    std::vector<uint8_t> period;                  // per chunk: q
+    std::vector<uint32_t> since;                  // per chunk: repeating with period q since
+    std::vector<uint8_t> parked;                  // per chunk: replayed this frame
+    std::vector<uint8_t> timed;                   // per chunk: a timed rule may fire in it
+    std::vector<std::vector<uint8_t>> cycle;      // per tracked chunk: state f at f % q
+    std::vector<uint64_t> hist;                   // per chunk: hash of state f at f % HIST
+    std::vector<uint8_t> histLen;                 // per chunk: valid hashes in hist
+    unsigned long long parkedFrames = 0;          // chunk-frames parked instead of stepped
+    unsigned long long aheadTiles = 0;            // copies stepped by stepAhead()
+
+    void disturb(size_t c) {                      // chunk c changed outside a step
+        period[c] = 1;
+        since[c] = frame + 1;
+        parked[c] = 0;
+        histLen[c] = 0;
+        cycle[c].clear();
+    }
+    void parkChunks(int reach) {
+        if (wakeAll) { for (size_t c = 0; c < (size_t)gw * gh; ++c) disturb(c); return; }
+        const int k = (reach + 1 + CHUNK - 1) / CHUNK;
+        for (int cy = 0; cy < gh; ++cy)
+            for (int cx = 0; cx < gw; ++cx) {
+                const size_t c = (size_t)cy * gw + cx;
+                parked[c] = 0;
+                const int nx0 = std::max(0, cx - k), nx1 = std::min(gw - 1, cx + k);
+                const int ny0 = std::max(0, cy - k), ny1 = std::min(gh - 1, cy + k);
+                int p = 1;
+                for (int ny = ny0; ny <= ny1 && p <= PARK_PERIOD; ++ny)
+                    for (int nx = nx0; nx <= nx1; ++nx) p = std::lcm(p, (int)period[(size_t)ny * gw + nx]);
+                if (p > PARK_PERIOD) continue;
+                bool ok = true;
+                for (int ny = ny0; ny <= ny1 && ok; ++ny)
+                    for (int nx = nx0; nx <= nx1 && ok; ++nx) {
+                        const size_t n = (size_t)ny * gw + nx;
+                        ok = !timed[n] && (long long)frame - p + period[n] >= since[n];
+                    }
+                parked[c] = ok;
+            }
+    }
+    uint64_t hashChunk(size_t c) const {
+        const Rect r = chunkRect((int)(c % gw), (int)(c / gw));
+        uint64_t h = 0;
+        for (int y = r.y0; y < r.y1; ++y)
+            for (int x = r.x0; x < r.x1; x += 8) {
+                uint64_t w;
+                std::memcpy(&w, &grid[(size_t)y * SW + x], 8);
+                h = (h ^ w) * 0x9e3779b97f4a7c15ull;
+                h ^= h >> 29;
+            }
+        return h;
+    }
+    // Chunk c against (or into) a CHUNK x CHUNK copy.
+    bool sameChunk(size_t c, const uint8_t* s) const {
+        const Rect r = chunkRect((int)(c % gw), (int)(c / gw));
+        for (int y = r.y0; y < r.y1; ++y, s += CHUNK)
+            if (std::memcmp(&grid[(size_t)y * SW + r.x0], s, CHUNK)) return false;
+        return true;
+    }
+    void copyChunk(size_t c, uint8_t* s) const {
+        const Rect r = chunkRect((int)(c % gw), (int)(c / gw));
+        for (int y = r.y0; y < r.y1; ++y, s += CHUNK) std::memcpy(s, &grid[(size_t)y * SW + r.x0], CHUNK);
+    }
+    // Chunk c's state after this frame (frame + 1), which `changed` from the last.
+    void track(size_t c, bool changed) {
+        const uint32_t now = frame + 1;
+        const int q = period[c];
+        if (q > 1) {
+            uint8_t* s = &cycle[c][(size_t)(now % q) * CHUNK * CHUNK];
+            if (parked[c]) return;                    // replayed from s: repeats by construction
+            if (now < since[c]) { copyChunk(c, s); return; }   // still recording
+            if (sameChunk(c, s)) return;
+            period[c] = 1;
+            cycle[c].clear();
+            since[c] = now;
+        }
+        if (changed) since[c] = now + 1;
+        if (timed[c]) { histLen[c] = 0; return; }     // cannot park: no need for candidates
+        uint64_t* h = &hist[c * HIST];
+        h[now % HIST] = changed || !histLen[c] ? hashChunk(c) : h[(now - 1) % HIST];
+        if (histLen[c] < HIST) ++histLen[c];
+        // A candidate cycle: the chunk changed within the last p frames, and its last
+        // 2p hashes repeat with period p.
+        for (int p = 2; p <= PARK_PERIOD && 2 * p <= histLen[c]; ++p) {
+            if ((long long)since[c] < (long long)now - p + 2) continue;
+            bool rep = true;
+            for (int j = 0; j < p && rep; ++j) rep = h[(now - j) % HIST] == h[(now - j - p) % HIST];
+            if (!rep) continue;
+            period[c] = (uint8_t)p;
+            since[c] = now + p;
+            histLen[c] = 0;                           // not kept while tracked
+            cycle[c].resize((size_t)p * CHUNK * CHUNK);
+            copyChunk(c, &cycle[c][(size_t)(now % p) * CHUNK * CHUNK]);
+            break;
+        }
+    }
+
+    // --- fused reactions -----------------------------------------------------
+    // The one-thread step runs a rectangle's reaction passes as one sweep down its rows
+    // rather than one sweep per pass. A pass works row y once the pass before it has
+    // finished row y+1 (a mark reads the grid a row down and may overwrite marks the
+    // apply before it still reads there; an apply reads its marks a row down), so each
+    // pass trails the one before by a row and the whole chain works on the same few
+    // dozen rows while they are in cache -- the pass order, and the frame, unchanged.
+    // A pass also runs only on the rows and chunk columns whose neighbourhood holds its
+    // trigger (Reaction::a/b), looked up in `has`: per row and chunk column, the
+    // materials there after movement, widened by every apply that ran on it since by
+    // the apply's `makes`. A skipped mark could not have changed anything; a pass whose
+    // apply reads the marks around it (reach 2) zeroes the marks it skipped instead.
+    // A reach-1 apply changes only cells whose own mark is set, so its mark lists the
+    // runs of marked cells it wrote (markRuns) and the apply visits just those: a quiet
+    // row costs its mark, not a second sweep. Runs closer than MARK_GAP are merged --
+    // applying an unmarked cell is a no-op -- so a row that is mostly marked (a belt
+    // line, whose idle mark is 255) is one run.
+    static constexpr int REACT_BAND = 8;   // rows the first pass runs ahead per step
+    static constexpr int MARK_GAP = 16;    // cells between two runs of marks kept apart
+    struct MarkRun { uint32_t a, b; };   // grid cells [a, b) of one row
+    std::vector<int> reactPasses;        // 2 * reaction index + 1 for an apply
+    std::vector<int> reactDone;          // per pass: rows finished
+    std::vector<MatMask> has;            // per (row, chunk column), with a ring of one
+    std::vector<uint8_t> marked;         // per (pass, row, chunk column): the mark ran
+    std::vector<std::vector<MarkRun>> markRuns;   // per mark pass: the runs, in row order
+    std::vector<size_t> markNext;        // per mark pass: the first run its apply has not visited
+    std::vector<uint8_t> reactRun;       // per chunk column: reactRow runs the pass there
+    const bool fuseReact = fusedReactions();
+
+    void react(const Rect& r) {
+        reactPasses.clear();
+        for (int i = 0; i < (int)(sizeof(kReactions) / sizeof(kReactions[0])); ++i) {
+            if (!runs(kReactions[i])) continue;
+            reactPasses.push_back(2 * i);
+            if (kReactions[i].reach > 0) reactPasses.push_back(2 * i + 1);   // decayFire has no apply
+        }
+        const int np = (int)reactPasses.size();
+        const int ns = (r.x1 - r.x0) / CHUNK, NS = ns + 2, rows = r.y1 - r.y0 + 2;
+        has.assign((size_t)rows * NS, MatMask{});
+        for (int y = r.y0 - 1; y <= r.y1; ++y) {
+            const uint8_t* g = &grid[(size_t)y * SW];
+            MatMask* h = &has[(size_t)(y - r.y0 + 1) * NS];
+            for (int x = r.x0 - 1; x <= r.x1; ++x) h[(x - r.x0 + CHUNK) / CHUNK].add(g[x]);
+        }
+        marked.assign((size_t)np * rows * NS, 0);
+        if ((int)markRuns.size() < np) markRuns.resize(np);
+        for (int p = 0; p < np; ++p) markRuns[p].clear();
+        markNext.assign(np, 0);
+        reactRun.resize(NS);
+        reactDone.assign(np, r.y0);
+
+        while (reactDone[np - 1] < r.y1)
+            for (int p = 0; p < np; ++p) {
+                const int prev = p ? reactDone[p - 1] : 0;
+                const int lim = p == 0 ? std::min(r.y1, reactDone[0] + REACT_BAND) : prev == r.y1 ? r.y1 : prev - 1;
+                for (int y = reactDone[p]; y < lim; ++y) reactRow(r, p, y, ns);
+                reactDone[p] = std::max(reactDone[p], lim);
+            }
+    }
+
+    // One pass over row y of rectangle r, on the chunk columns that may react, with the
+    // columns that run next to each other in one call.
+    void reactRow(const Rect& r, int p, int y, int ns) {
+        const int NS = ns + 2, rows = r.y1 - r.y0 + 2, ry = y - r.y0 + 1;
+        const Reaction& rx = kReactions[reactPasses[p] >> 1];
+        const bool apply = reactPasses[p] & 1;
+        MatMask* h = &has[(size_t)ry * NS];
+        if (sparse[reactPasses[p] >> 1]) {            // only around the sites
+            std::vector<Span>& spans = memberSpans[0];
+            siteSpans(passSites[reactPasses[p] >> 1], y, siteReach(reactPasses[p] >> 1, apply), r.x0, r.x1, spans);
+            for (const Span& sp : spans) {
+                rx.run(grid.data(), scratch.data(), SW, sp.first, sp.second, y, y + 1, frame, apply ? APPLY_PASS : MARK_PASS);
+                if (apply)
+                    for (int t = (sp.first - r.x0) / CHUNK + 1; t <= (sp.second - 1 - r.x0) / CHUNK + 1; ++t) h[t] |= rx.makes;
+            }
+            return;
+        }
+        const size_t row = (size_t)y * SW;
+        if (apply && rx.reach == 1) {                 // only the marked runs
+            const std::vector<MarkRun>& runs = markRuns[p - 1];
+            size_t& k = markNext[p - 1];
+            for (; k < runs.size() && runs[k].a < row + SW; ++k) {
+                const int xa = (int)(runs[k].a - row), xb = (int)(runs[k].b - row);
+                rx.run(grid.data(), scratch.data(), SW, xa, xb, y, y + 1, frame, APPLY_PASS);
+                for (int t = (xa - r.x0) / CHUNK + 1; t <= (xb - 1 - r.x0) / CHUNK + 1; ++t) h[t] |= rx.makes;
+            }
+            return;
+        }
+        uint8_t* run = reactRun.data();
+        std::fill(run, run + NS, 0);
+        if (!apply) {
+            uint8_t* mk = &marked[((size_t)p * rows + ry) * NS];
+            for (int s = 1; s <= ns; ++s) {
+                MatMask near;
+                for (int dy = -1; dy <= 1; ++dy)
+                    for (int ds = -1; ds <= 1; ++ds) near |= h[dy * NS + s + ds];
+                run[s] = mk[s] = near.meets(rx.a) && (rx.b.empty() || near.meets(rx.b));
+            }
+        } else {
+            const uint8_t* mk = &marked[((size_t)(p - 1) * rows + ry) * NS];
+            for (int s = 1; s <= ns; ++s) {
+                if (rx.reach < 2) { run[s] = mk[s]; continue; }
+                for (int dy = -1; dy <= 1; ++dy)
+                    run[s] |= mk[dy * NS + s - 1] | mk[dy * NS + s] | mk[dy * NS + s + 1];
+            }
+        }
+        for (int s = 1; s <= ns;) {
+            int e = s + 1;
+            while (e <= ns && run[e] == run[s]) ++e;
+            const int xa = r.x0 + (s - 1) * CHUNK, xb = r.x0 + (e - 1) * CHUNK;
+            if (run[s]) {
+                rx.run(grid.data(), scratch.data(), SW, xa, xb, y, y + 1, frame, apply ? APPLY_PASS : MARK_PASS);
+                if (apply || rx.reach == 0)
+                    for (int t = s; t < e; ++t) h[t] |= rx.makes;
+                if (!apply && rx.reach == 1) listMarks(markRuns[p], row, xa, xb);
+            } else if (!apply && rx.reach == 2) {
+                std::memset(&scratch[(size_t)y * SW + xa], 0, (size_t)(xb - xa));
+            }
+            s = e;
+        }
+    }
+
+    // Append the marked cells of row `row`, columns [xa, xb), to `runs`, 8 marks at a time.
+    void listMarks(std::vector<MarkRun>& runs, size_t row, int xa, int xb) {
+        for (int x = xa; x < xb; x += 8) {
+            uint64_t w;
+            std::memcpy(&w, &scratch[row + x], 8);                // the row's padding covers the overrun
+            if (xb - x < 8) w &= ~0ull >> 8 * (8 - (xb - x));       // little-endian: byte k is column x+k
+            if (!w) continue;
+            const uint32_t a = (uint32_t)(row + x + __builtin_ctzll(w) / 8), b = (uint32_t)(row + x + 8 - __builtin_clzll(w) / 8);
+            if (!runs.empty() && runs.back().b > row && a - runs.back().b < MARK_GAP) runs.back().b = b;
+            else runs.push_back({a, b});
+        }
+    }
+
+    // --- per-chunk reaction gates ---------------------------------------------
+    // `resident` is the spatial counterpart of `present`. Movement carries a cell at
+    // most MOVE_REACH < CHUNK cells and a reaction reads at most two cells around it, so
+    // before the reactions a chunk holds nothing its 3x3 block of chunks did not, and a
+    // pass can only fire in a chunk whose 3x3 block holds its trigger (Reaction::a/b;
+    // the window's edge chunks also see the WALL border). Walking the running passes in
+    // order -- a pass that may fire in a chunk may leave its `makes` there -- gives, per
+    // reaction and chunk, whether the pass can do anything there this frame. The task
+    // graph skips the (chunk, pass) tasks where it cannot.
+    std::vector<uint8_t> chunkFires;    // per (reaction, chunk)
+    std::vector<MatMask> chunkMay, chunkNear;
+
+    void gateChunks() {
+        const int n = gw * gh, nr = (int)(sizeof(kReactions) / sizeof(kReactions[0]));
+        chunkFires.assign((size_t)nr * n, 0);
+        chunkMay.resize(n);
+        chunkNear.resize(n);
+        auto gather = [&](const std::vector<MatMask>& in, std::vector<MatMask>& out) {
+            for (int cy = 0; cy < gh; ++cy)
+                for (int cx = 0; cx < gw; ++cx) {
+                    MatMask m;
+                    if (cx == 0 || cy == 0 || cx == gw - 1 || cy == gh - 1) m.add(WALL);
+                    for (int ny = std::max(0, cy - 1); ny <= std::min(gh - 1, cy + 1); ++ny)
+                        for (int nx = std::max(0, cx - 1); nx <= std::min(gw - 1, cx + 1); ++nx) m |= in[(size_t)ny * gw + nx];
+                    out[(size_t)cy * gw + cx] = m;
+                }
+        };
+        gather(resident, chunkMay);
+        for (int i = 0; i < nr; ++i) {
+            const Reaction& rx = kReactions[i];
+            if (!runs(rx)) continue;
+            gather(chunkMay, chunkNear);
+            for (int c = 0; c < n; ++c)
+                if (chunkNear[c].meets(rx.a) && (rx.b.empty() || chunkNear[c].meets(rx.b))) {
+                    chunkFires[(size_t)i * n + c] = 1;
+                    chunkMay[c] |= rx.makes;
+                }
+        }
+    }
+    // Reaction i's apply reads the marks of chunk (cx, cy) and, at reach 2, the marks
+    // around it: it runs if any of those marks did.
+    bool applyFires(int i, int cx, int cy) const {
+        const uint8_t* f = &chunkFires[(size_t)i * gw * gh];
+        if (kReactions[i].reach < 2) return f[(size_t)cy * gw + cx];
+        for (int ny = std::max(0, cy - 1); ny <= std::min(gh - 1, cy + 1); ++ny)
+            for (int nx = std::max(0, cx - 1); nx <= std::min(gw - 1, cx + 1); ++nx)
+                if (f[(size_t)ny * gw + nx]) return true;
+        return false;
+    }
+
+    // --- threads -------------------------------------------------------------
+    // With --threads N a rectangle's frame is a graph of (chunk, pass) tasks run by a
+    // team of N threads (see wavefront.h): a chunk's pass starts once it and its 8
+    // neighbours finished the pass before, so there is no frame-wide barrier. The
+    // passes are a prepare task, the 16 movement sub-passes (exclusive: a sub-pass
+    // writes a cell past its chunk) and each running reaction's mark and apply. Every
+    // pass only swaps or rewrites disjoint cells and reads at most one cell past the
+    // chunk, so any order the graph allows gives the single-threaded frame.
+    //
+    // SANDSIM_SCHED=bands instead splits the rectangle into N row bands that run one
+    // pass at a time with a barrier between passes (the edge rows of a movement
+    // sub-pass take a second barrier, see StepBand). Bands are whole 8-row groups and
+    // at least STEP_BAND_MIN_ROWS tall; a short rectangle leaves some members idle.
+    ThreadPool pool{g_threads};
+    Wavefront wave;
+    std::vector<uint64_t> bandSkipped;   // per member, for blocksSkipped
+    std::vector<SpanSum> chunkSpans;     // per chunk: its movement span summaries
+    GridBuffer memberBlocks;             // per member: its StepTask::blocks, memberBlockBytes() each
+    std::vector<uint8_t> exclusive;      // per pass of the task graph
+    static size_t memberBlockBytes() { return (stepBlockBytes(CHUNK) + GRID_ALIGN - 1) / GRID_ALIGN * GRID_ALIGN; }
+
+    // --- tile-major layout -----------------------------------------------------
+    // With GridLayout::Tiles a task frame runs every chunk of the rectangle on a tile of
+    // its own: one contiguous block per chunk -- its cells and a ring around them, padded
+    // like the live grid -- so a task's rows are neighbours in memory rather than SW bytes
+    // apart. The prepare task copies the chunk's cells in and the end of the frame copies
+    // them back. Between, each pass first takes the one-cell ring it reads from whoever
+    // holds those cells (a neighbour's tile, or the live grid outside the rectangle); a
+    // movement sub-pass, which may write the ring, returns it when done. The task graph
+    // already orders these: a pass reads its neighbours only once they finished the pass
+    // before, and no neighbour runs an exclusive pass (the sub-passes) at the same time.
+    static constexpr int TILE_STRIDE = gridStride(CHUNK, PAD);
+    static constexpr int TILE_HALO = 8;                          // rows, so `moved` packs alike
+    static constexpr size_t TILE_BYTES = (size_t)TILE_STRIDE * (CHUNK + 2 * TILE_HALO);
+    static constexpr size_t TILE_MOVED_BYTES = TILE_BYTES / 8;
+    enum TileBuf { TB_GRID, TB_SCRATCH, TB_MOVED };
+    // A tile addressed like the live buffers, at its chunk's coordinates: cell (x, y) is
+    // grid[y * TILE_STRIDE + x] for the chunk and its ring, packed `moved` row y alike.
+    // (The bases themselves point outside the tile.)
+    struct TileCells { uint8_t* b[3]; };
+    const GridLayout layout;
+    GridBuffer tileGrid, tileScratch, tileMoved;   // gw * gh tiles, interiors on cache lines
+    std::vector<TileCells> tiles;                  // the stepped rectangle's, row-major
+    int tileCols = 0;
+
+    void bindTiles(const Rect& r) {
+        tileCols = (r.x1 - r.x0) / CHUNK;
+        tiles.resize((size_t)tileCols * ((r.y1 - r.y0) / CHUNK));
+        for (size_t k = 0; k < tiles.size(); ++k) {
+            const int x0 = r.x0 + (int)(k % tileCols) * CHUNK, y0 = r.y0 + (int)(k / tileCols) * CHUNK;
+            const ptrdiff_t off = (ptrdiff_t)(y0 - TILE_HALO) * TILE_STRIDE + (x0 - PAD);
+            const ptrdiff_t moff = (ptrdiff_t)((y0 - TILE_HALO) / 8) * TILE_STRIDE + (x0 - PAD);
+            tiles[k] = {{tileGrid.data() + k * TILE_BYTES - off, tileScratch.data() + k * TILE_BYTES - off,
+                         tileMoved.data() + k * TILE_MOVED_BYTES - moff}};
+        }
+    }
+    uint8_t* liveBuf(int b) { return b == TB_GRID ? grid.data() : b == TB_SCRATCH ? scratch.data() : moved.data(); }
+    // Where row y (packed for `moved`), column x of buffer b is held during a tiled frame.
+    uint8_t* tileOwner(const Rect& r, int b, int x, int y) {
+        const int cy = b == TB_MOVED ? 8 * y : y;
+        if (x < r.x0 || x >= r.x1 || cy < r.y0 || cy >= r.y1) return liveBuf(b) + (size_t)y * SW + x;
+        const TileCells& t = tiles[(size_t)((cy - r.y0) / CHUNK) * tileCols + (x - r.x0) / CHUNK];
+        return t.b[b] + (size_t)y * TILE_STRIDE + x;
+    }
+    // Copy chunk k's ring of buffer b into its tile from whoever holds it (push: back).
+    // `moved` is packed 8 rows deep, so its ring rows are the packed rows either side.
+    // live: from the live buffer -- the prepare task, before any tile has changed.
+    void tileRing(const Rect& r, int k, int b, bool push, bool live = false) {
+        const int x0 = r.x0 + (k % tileCols) * CHUNK, y0 = r.y0 + (k / tileCols) * CHUNK;
+        const int ya = b == TB_MOVED ? y0 / 8 - 1 : y0 - 1, yb = b == TB_MOVED ? (y0 + CHUNK) / 8 : y0 + CHUNK;
+        uint8_t* own = tiles[k].b[b];
+        auto copy = [&](int x, int y, int n) {
+            uint8_t* t = own + (size_t)y * TILE_STRIDE + x;
+            uint8_t* o = live ? liveBuf(b) + (size_t)y * SW + x : tileOwner(r, b, x, y);
+            if (push) std::memcpy(o, t, n); else std::memcpy(t, o, n);
+        };
+        for (int y : {ya, yb}) { copy(x0 - 1, y, 1); copy(x0, y, CHUNK); copy(x0 + CHUNK, y, 1); }
+        for (int y = ya + 1; y < yb; ++y) { copy(x0 - 1, y, 1); copy(x0 + CHUNK, y, 1); }
+    }
+    // Copy chunk k's own cells into its tile (out: back to the live buffers, `moved` too).
+    void tileCells(const Rect& r, int k, bool out) {
+        const int x0 = r.x0 + (k % tileCols) * CHUNK, y0 = r.y0 + (k / tileCols) * CHUNK;
+        for (int b = TB_GRID; b <= (out ? TB_MOVED : TB_SCRATCH); ++b) {
+            const int ya = b == TB_MOVED ? y0 / 8 : y0, yb = b == TB_MOVED ? (y0 + CHUNK) / 8 : y0 + CHUNK;
+            for (int y = ya; y < yb; ++y) {
+                uint8_t* t = tiles[k].b[b] + (size_t)y * TILE_STRIDE + x0;
+                uint8_t* l = liveBuf(b) + (size_t)y * SW + x0;
+                if (out) std::memcpy(l, t, CHUNK); else std::memcpy(t, l, CHUNK);
+            }
+        }
+    }
+
+    void stepTasks(const Rect& r) {
+        struct Pass { int kind, idx; };                 // 0 prepare, 1 sub-pass, 2 mark, 3 apply
+        std::vector<Pass> passes{{0, 0}};
+        for (int p = 0; p < STEP_SUBPASSES; ++p) passes.push_back({1, p});
+        if (hasReactive)
+            for (int i = 0; i < (int)(sizeof(kReactions) / sizeof(kReactions[0])); ++i)
+                if (runs(kReactions[i])) { passes.push_back({2, i}); passes.push_back({3, i}); }
+        exclusive.assign(passes.size(), 0);
+        for (size_t p = 0; p < passes.size(); ++p) exclusive[p] = passes[p].kind == 1;
+
+        const int cw = (r.x1 - r.x0) / CHUNK, ch = (r.y1 - r.y0) / CHUNK;
+        const int gx = (r.x0 - X0) / CHUNK, gy = (r.y0 - Y0) / CHUNK;   // the rectangle's first chunk
+        const size_t per = spanSumCount(0, CHUNK, 0, CHUNK);
+        const bool tiled = layout == GridLayout::Tiles;
+        if (tiled) bindTiles(r);
+        std::fill(bandSkipped.begin(), bandSkipped.end(), 0);
+        wave.run(pool, cw, ch, exclusive, [&](int t, int cx, int cy, int p) {
+            const int x0 = r.x0 + cx * CHUNK, y0 = r.y0 + cy * CHUNK, k = cy * cw + cx;
+            const Pass& ps = passes[p];
+            uint8_t* g = grid.data();
+            uint8_t* s = scratch.data();
+            uint8_t* m = moved.data();
+            int S = SW;
+            if (tiled) {                                    // the ring this pass reads
+                g = tiles[k].b[TB_GRID]; s = tiles[k].b[TB_SCRATCH]; m = tiles[k].b[TB_MOVED]; S = TILE_STRIDE;
+                if (ps.kind == 0) { tileCells(r, k, false); tileRing(r, k, TB_GRID, false, true); }
+                else if (ps.kind == 1) { tileRing(r, k, TB_GRID, false); tileRing(r, k, TB_MOVED, false); }
+                else tileRing(r, k, ps.kind == 2 ? TB_GRID : TB_SCRATCH, false);
+            }
+            if (ps.kind >= 2) {
+                const Reaction& rx = kReactions[ps.idx];
+                const bool mark = ps.kind == 2;
+                if (!(mark ? chunkFires[(size_t)ps.idx * gw * gh + (size_t)(gy + cy) * gw + gx + cx]
+                           : applyFires(ps.idx, gx + cx, gy + cy))) {
+                    if (mark && rx.reach == 2)                 // the applies around read these marks
+                        for (int y = y0; y < y0 + CHUNK; ++y) std::memset(&s[(size_t)y * S + x0], 0, CHUNK);
+                } else if (sparse[ps.idx])
+                    runSites(ps.idx, x0, x0 + CHUNK, y0, y0 + CHUNK, mark ? MARK_PASS : APPLY_PASS, memberSpans[t], g, s, S);
+                else
+                    rx.run(g, s, S, x0, x0 + CHUNK, y0, y0 + CHUNK, frame, mark ? MARK_PASS : APPLY_PASS);
+                return;
+            }
+            // The prepare task clears `moved` as the one-thread step does: whole rows, so
+            // the rectangle's edge chunks also clear the columns beyond it. A tile's rows
+            // are cleared whole, and those columns in the live plane.
+            int clearX0 = cx == 0 ? 0 : x0, clearX1 = cx == cw - 1 ? SW : x0 + CHUNK;
+            if (tiled) {
+                if (ps.kind == 0)
+                    for (int y = y0 / 8; y < (y0 + CHUNK) / 8; ++y) {
+                        std::memset(&moved[(size_t)y * SW + clearX0], 0, (size_t)(x0 - clearX0));
+                        std::memset(&moved[(size_t)y * SW + x0 + CHUNK], 0, (size_t)(clearX1 - x0 - CHUNK));
+                    }
+                clearX0 = x0 - PAD; clearX1 = x0 - PAD + TILE_STRIDE;
+            }
+            StepTask task{ps.kind == 0 ? -1 : ps.idx, clearX0, clearX1, &chunkSpans[(size_t)k * per],
+                          &memberBlocks[(size_t)t * memberBlockBytes()]};
+            bandSkipped[t] += g_taskStep(g, m, S, x0, x0 + CHUNK, y0, y0 + CHUNK, frame, &task, moveMats());
+            if (tiled && ps.kind == 1) { tileRing(r, k, TB_GRID, true); tileRing(r, k, TB_MOVED, true); }
+        });
+        if (tiled)
+            for (int k = 0; k < cw * ch; ++k) tileCells(r, k, true);
+        for (uint64_t s : bandSkipped) blocksSkipped += s;
+    }
+
+    void stepBanded(const Rect& r) {
+        const int units = (r.y1 - r.y0) / 8;
+        const int nb = std::max(1, std::min(pool.size(), units / (STEP_BAND_MIN_ROWS / 8)));
+        pool.run([&](int t) {
+            StepBand b{r.y1, r.y1, ThreadPool::syncThunk, &pool};
+            if (t < nb) {
+                b.ya = r.y0 + 8 * (int)((long long)units * t / nb);
+                b.yb = (t + 1 == nb) ? r.y1 : r.y0 + 8 * (int)((long long)units * (t + 1) / nb);
+            }
+            bandSkipped[t] = g_bandStep(grid.data(), moved.data(), SW, r.x0, r.x1, r.y0, r.y1, frame, &b, moveMats());
+            if (!hasReactive) return;
+            for (int i = 0; i < (int)(sizeof(kReactions) / sizeof(kReactions[0])); ++i) {
+                const Reaction& rx = kReactions[i];
+                if (!runs(rx)) continue;
+                for (int pass : {MARK_PASS, APPLY_PASS}) {
+                    if (sparse[i]) runSites(i, r.x0, r.x1, b.ya, b.yb, pass, memberSpans[t]);
+                    else rx.run(grid.data(), scratch.data(), SW, r.x0, r.x1, b.ya, b.yb, frame, pass);
+                    pool.sync();
+                }
+            }
+        });
+        for (uint64_t s : bandSkipped) blocksSkipped += s;
+    }
+
+    // --- temporal tiles -----------------------------------------------------
+    // step(K), K > 1: the window is cut into cores of whole chunks, and each core is
+    // stepped all K frames before the next is touched, in a private copy of it and a halo
+    // of ceil(K * (reach + 1) / CHUNK) chunks -- the margin wakeRects() grows a frame's
+    // rectangles by, once per frame. A cell that far inside the copy sees what
+    // the whole window would for K frames, so the copy's core ends where K single frames
+    // leave it; the halo goes stale from its open edges in and is dropped. A copy keeps
+    // the grid's stride and addressing (the parities and the WALL border are where a
+    // frame expects them) and is sized to stay in L2 for its K frames. The cores are
+    // written into `prev`, which then swaps with the grid, leaving the old frame there
+    // for settle(). The K frames run every pass that can run in any of them -- gated on
+    // what is resident or can be made from it, as a pass gated off is a no-op -- each
+    // as a sweep of the copy. A site pass runs around the sites the copy starts with,
+    // widened by MOVE_REACH per frame for those that move; another pass sweeps the
+    // chunks that start with one side of its trigger (Reaction::a/b), grown by its reach
+    // and MOVE_REACH per frame -- its marks a cell further, so the apply reads no stale
+    // mark. Either only if no pass may make those materials within the K frames. No
+    // fused sweep. Workers take whole cores. Every chunk is stepped -- nothing sleeps or
+    // parks -- and the next single frame wakes the window and starts parking over.
+    static constexpr size_t AHEAD_TILE_BYTES = 2048 * 1024;   // grid + scratch + moved bytes per copy (about an L2)
+    struct AheadCopy {
+        GridBuffer grid, scratch, moved;
+        std::vector<std::vector<Site>> sites;   // per reaction: the copy's sites, by row
+        std::vector<uint8_t> sparse;            // per reaction: runs on `sites`
+        std::vector<Rect> near;                 // per reaction: the chunks with its trigger (empty: none)
+    };
+    std::unique_ptr<AheadCopy[]> ahead;                // per member
+
+    // The passes that can run on materials `can` over any number of frames, and what
+    // they can make: `can` grows to a fixpoint.
+    std::vector<int> passesAhead(MatMask& can) const {
+        std::vector<int> live;
+        if (!can.meets(kReactive)) return live;
+        for (bool grew = true; grew;) {
+            grew = false;
+            for (const Reaction& r : kReactions)
+                if ((r.gate.empty() || can.meets(r.gate)) && ((r.makes.w[0] & ~can.w[0]) | (r.makes.w[1] & ~can.w[1]))) {
+                    can |= r.makes;
+                    grew = true;
+                }
+        }
+        for (int i = 0; i < (int)(sizeof(kReactions) / sizeof(kReactions[0])); ++i)
+            if (kReactions[i].gate.empty() || can.meets(kReactions[i].gate)) live.push_back(i);
+        return live;
+    }
+
+    void stepAhead(int K) {
+        livePasses();
+        MatMask can = present;                          // what any of the K frames may hold
+        int reach = MOVE_REACH;
+        for (int i : passesAhead(can)) reach += kReactions[i].reach;
+        const int halo = (K * (reach + 1) + CHUNK - 1) / CHUNK;
+        const double perCell = 2.0 + 1.0 / 8;
+        int side = std::max(1, (int)(std::sqrt(AHEAD_TILE_BYTES / perCell) / CHUNK) - 2 * halo);
+        if ((double)LW * LH * perCell <= AHEAD_TILE_BYTES) side = std::max(gw, gh);   // one copy, no halo
+        const int cw = std::min(gw, side), ch = std::min(gh, side);
+        const int tx = (gw + cw - 1) / cw, tiles = tx * ((gh + ch - 1) / ch);
+        if (!ahead) {
+            ahead.reset(new AheadCopy[pool.size()]);
+            for (int t = 0; t < pool.size(); ++t) {
+                ahead[t].grid.assign((size_t)SW * SH, WALL, X0);
+                ahead[t].scratch.assign((size_t)SW * SH, 0, X0);
+                ahead[t].moved.assign(movedBytes(SW, SH), 0, X0);
+            }
+        }
+        std::atomic<int> nextTile{0};
+        pool.run([&](int t) {
+            AheadCopy& a = ahead[t];
+            bandSkipped[t] = 0;
+            for (int k; (k = nextTile++) < tiles;) {
+                const int cx0 = k % tx * cw, cy0 = k / tx * ch, cx1 = std::min(gw, cx0 + cw), cy1 = std::min(gh, cy0 + ch);
+                const Rect core = {X0 + cx0 * CHUNK, Y0 + cy0 * CHUNK, X0 + cx1 * CHUNK, Y0 + cy1 * CHUNK};
+                const Rect w = {X0 + std::max(0, cx0 - halo) * CHUNK, Y0 + std::max(0, cy0 - halo) * CHUNK,
+                                X0 + std::min(gw, cx1 + halo) * CHUNK, Y0 + std::min(gh, cy1 + halo) * CHUNK};
+                // The copy is a world of its own: only what its chunks (and those its
+                // 1-cell ring reaches into) hold can be in it, and only the passes
+                // gated on that can do anything there.
+                MatMask here;
+                for (int cy = std::max(0, cy0 - halo - 1); cy < std::min(gh, cy1 + halo + 1); ++cy)
+                    for (int cx = std::max(0, cx0 - halo - 1); cx < std::min(gw, cx1 + halo + 1); ++cx) here |= resident[(size_t)cy * gw + cx];
+                const std::vector<int> live = passesAhead(here);
+                MatMask made;                                 // what the K frames may write
+                for (int i : live) made |= kReactions[i].makes;
+                a.sites.resize(sizeof(kReactions) / sizeof(kReactions[0]));
+                a.sparse.assign(a.sites.size(), 0);
+                a.near.resize(a.sites.size());
+                for (int i : live) {
+                    const Reaction& rx = kReactions[i];
+                    const MatMask trig = !made.meets(rx.a) ? rx.a : !rx.b.empty() && !made.meets(rx.b) ? rx.b : MatMask{};
+                    Rect& b = a.near[i];
+                    b = trig.empty() ? w : Rect{};
+                    for (int cy = (w.y0 - Y0) / CHUNK; cy < (w.y1 - Y0) / CHUNK && !trig.empty(); ++cy)
+                        for (int cx = (w.x0 - X0) / CHUNK; cx < (w.x1 - X0) / CHUNK; ++cx)
+                            if (resident[(size_t)cy * gw + cx].meets(trig)) {
+                                const Rect c = chunkRect(cx, cy);
+                                b = b.empty() ? c : Rect{std::min(b.x0, c.x0), std::min(b.y0, c.y0), std::max(b.x1, c.x1), std::max(b.y1, c.y1)};
+                            }
+                    if (!useSites || rx.sites.empty() || made.meets(rx.sites)) continue;
+                    std::vector<Site>& v = a.sites[i];
+                    v.clear();
+                    for (int cy = (w.y0 - Y0) / CHUNK; cy < (w.y1 - Y0) / CHUNK; ++cy)
+                        for (int cx = (w.x0 - X0) / CHUNK; cx < (w.x1 - X0) / CHUNK; ++cx)
+                            for (const Site& st : chunkSites[(size_t)cy * gw + cx]) if (rx.sites.has(st.m)) v.push_back(st);
+                    std::sort(v.begin(), v.end());
+                    const long long side = 2 * (rx.reach + (rx.sites.meets(kDriftingSites) ? K * MOVE_REACH : 0)) + 1;
+                    a.sparse[i] = (long long)v.size() * side * side * 4 < (long long)(w.x1 - w.x0) * (w.y1 - w.y0);
+                }
+                for (int y = w.y0 - 1; y < w.y1 + 1; ++y)    // the copy and its 1-cell ring
+                    std::memcpy(&a.grid[(size_t)y * SW + w.x0 - 1], &grid[(size_t)y * SW + w.x0 - 1], (size_t)(w.x1 - w.x0 + 2));
+                for (int j = 0; j < K; ++j) {
+                    bandSkipped[t] += g_step(a.grid.data(), a.moved.data(), SW, w.x0, w.x1, w.y0, w.y1, frame + j, specialise ? here.w : nullptr);
+                    for (int i : live) {
+                        const Reaction& rx = kReactions[i];
+                        const Rect& b = a.near[i];
+                        if (b.empty()) continue;
+                        if (!a.sparse[i]) {
+                            const int m = (j + 1) * MOVE_REACH + rx.reach;
+                            const Rect r = {std::max(w.x0, b.x0 - m), std::max(w.y0, b.y0 - m), std::min(w.x1, b.x1 + m), std::min(w.y1, b.y1 + m)};
+                            rx.run(a.grid.data(), a.scratch.data(), SW, std::max(w.x0, r.x0 - 1), std::min(w.x1, r.x1 + 1), std::max(w.y0, r.y0 - 1),
+                                   std::min(w.y1, r.y1 + 1), frame + j, MARK_PASS);
+                            rx.run(a.grid.data(), a.scratch.data(), SW, r.x0, r.x1, r.y0, r.y1, frame + j, APPLY_PASS);
+                            continue;
+                        }
+                        const int drift = rx.sites.meets(kDriftingSites) ? (j + 1) * MOVE_REACH : 0;
+                        for (int pass : {MARK_PASS, APPLY_PASS})
+                            for (int y = w.y0; y < w.y1; ++y) {
+                                siteSpans(a.sites[i], y, (pass == APPLY_PASS ? 1 : rx.reach) + drift, w.x0, w.x1, memberSpans[t]);
+                                for (const Span& sp : memberSpans[t])
+                                    rx.run(a.grid.data(), a.scratch.data(), SW, sp.first, sp.second, y, y + 1, frame + j, pass);
+                            }
+                    }
+                }
+                for (int y = core.y0; y < core.y1; ++y)
+                    std::memcpy(&prev[(size_t)y * SW + core.x0], &a.grid[(size_t)y * SW + core.x0], (size_t)(core.x1 - core.x0));
+            }
+        });
+        for (int k = 0; k < tiles; ++k) {
+            const int cx0 = k % tx * cw, cy0 = k / tx * ch;
+            const int wx = std::min(gw, cx0 + cw + halo) - std::max(0, cx0 - halo), wy = std::min(gh, cy0 + ch + halo) - std::max(0, cy0 - halo);
+            blocksTotal += 14ull * K * wy * CHUNK * ((wx * CHUNK + simdWidth() - 1) / simdWidth());
+        }
+        for (uint64_t s : bandSkipped) blocksSkipped += s;
+        aheadTiles += tiles;
+        grid.swap(prev);
+        std::fill(awake.begin(), awake.end(), 1);
+        std::fill(parked.begin(), parked.end(), 0);
+        settle(false);
+        wakeAll = true;                                 // the next frame wakes and starts parking over
+        frame += K;
+    }
 
     // --- chunk <-> interior, disk -------------------------------------------
+    // A chunk row is one cache line of the grid (see grid_buffer.h), so a row at a time.
     void extractChunk(int cgx, int cgy, std::vector<uint8_t>& out) const {
         for (int ly = 0; ly < CHUNK; ++ly)
-            for (int lx = 0; lx < CHUNK; ++lx)
-                out[ly * CHUNK + lx] = grid[(size_t)(Y0 + cgy * CHUNK + ly) * SW + (X0 + cgx * CHUNK + lx)];
+            std::memcpy(&out[ly * CHUNK], &grid[(size_t)(Y0 + cgy * CHUNK + ly) * SW + (X0 + cgx * CHUNK)], CHUNK);
     }
     void injectChunk(int cgx, int cgy, const std::vector<uint8_t>& in) {
         for (int ly = 0; ly < CHUNK; ++ly)
-            for (int lx = 0; lx < CHUNK; ++lx) {
-                uint8_t v = in[ly * CHUNK + lx];
-                present[v] = true;
-                if (v == FIRE || v == LAVA || v == STEAM || v == PLANT || v == ACID || v == SMOKE || v == ICE || v == SPRING || v == VOLCANO || v == VOID || v == WATER || v == VIRUS || v == SPARK || v == SALT || v == FROST || v == EMBER || v == CLONER || v == CRYSTAL || v == ANTIMATTER || v == MOSS || v == EHEAD || v == ETAIL || v == SENSOR || v == LIFE || v == GEYSER || v == PHOSPHORUS || v == CEMENT || v == CHLORINE || v == BATTERY || v == BURNFUSE || v == CRYO || v == LAMPLIT || v == PETRIFY || v == FIREWORK || v == SPROUT || v == BELT || v == MAGNET || v == LASER || v == BEAM || v == ICICLE) hasReactive = true;
-                grid[(size_t)(Y0 + cgy * CHUNK + ly) * SW + (X0 + cgx * CHUNK + lx)] = v;
-            }
+            std::memcpy(&grid[(size_t)(Y0 + cgy * CHUNK + ly) * SW + (X0 + cgx * CHUNK)], &in[ly * CHUNK], CHUNK);
+        const size_t c = (size_t)cgy * gw + cgx;
+        resident[c] = countChunk(c);
+        listSites(c);
     }
     void genBox(int cx, int cy, std::vector<uint8_t>& buf) {
         for (int y = 0; y < CHUNK; ++y)
@@ -282,27 +1410,40 @@ private:
 };
 
 // ---------------------------------------------------------------------------
-static int runBench(int steps, int wbox, int hbox) {
+#ifndef SANDSIM_NO_MAIN   // defined by tools/ tests that drive a SimdWorld themselves
+// SANDSIM_TEMPORAL=K has --bench advance the window K frames per step() call, each
+// L2-sized tile K frames before the next (see stepAhead()). Same result as K single
+// frames; only those calls skip sleeping and parking, which the tiles do not keep.
+static int temporalFrames() {
+    const char* e = std::getenv("SANDSIM_TEMPORAL");
+    return e ? std::max(1, std::atoi(e)) : 1;
+}
+
+static int runBench(int steps, int wbox, int hbox, GridLayout layout) {
     const int gw = 4, gh = 4;   // fixed live window for the bit-identical reference
     if (wbox < gw) wbox = gw;
     if (hbox < gh) hbox = gh;
     std::string dir = "/tmp/sandsim_world_simd_" + std::to_string(steps) + "_" +
                       std::to_string(wbox) + "x" + std::to_string(hbox);
     std::filesystem::remove_all(dir);
-    SimdWorld world(gw, gh, wbox, hbox, dir);
+    SimdWorld world(gw, gh, wbox, hbox, dir, layout);
     world.generateAllToDisk();
 
     uint64_t startCk, startCnt[MATERIAL_COUNT];
     world.summary(startCk, startCnt);
 
     int nposX = wbox - gw + 1, nposY = hbox - gh + 1, nWin = nposX * nposY;
+    auto visitOf = [&](int s) { return std::min(nWin - 1, (int)((long long)s * nWin / steps)); };
+    const int ahead = temporalFrames();
     auto start = std::chrono::steady_clock::now();
-    for (int s = 0; s < steps; ++s) {
-        int visit = (int)((long long)s * nWin / steps);
-        if (visit >= nWin) visit = nWin - 1;
+    for (int s = 0; s < steps;) {
+        const int visit = visitOf(s);
         int row = visit / nposX, col = visit % nposX;
         world.setWindow((row % 2 == 0) ? col : (nposX - 1 - col), row);
-        world.step();
+        int k = 1;                                      // SANDSIM_TEMPORAL: up to the next move
+        while (k < ahead && s + k < steps && visitOf(s + k) == visit) ++k;
+        world.step(k);
+        s += k;
     }
     auto end = std::chrono::steady_clock::now();
 
@@ -316,15 +1457,80 @@ static int runBench(int steps, int wbox, int hbox) {
     printf("RESULT impl=cpp_%s rule=world window=%dx%d wbox=%d hbox=%d steps=%d "
            "elapsed_ms=%.3f mcells_per_s=%.2f checksum=%016llx "
            "empty=%llu wall=%llu sand=%llu water=%llu gas=%llu "
-           "resident_max=%d disk_writes=%lld disk_reads=%lld conserved=%s\n",
+           "resident_max=%d disk_writes=%lld disk_reads=%lld blocks=%llu blocks_skipped=%llu awake=%.1f%% parked=%.1f%% conserved=%s\n",
            simdName(), gw, gh, wbox, hbox, steps, ms, mc, (unsigned long long)ck,
            (unsigned long long)cnt[EMPTY], (unsigned long long)cnt[WALL],
            (unsigned long long)cnt[SAND], (unsigned long long)cnt[WATER], (unsigned long long)cnt[GAS],
-           world.residentMaxCount(), world.diskWrites(), world.diskReads(), conserved ? "yes" : "no");
+           world.residentMaxCount(), world.diskWrites(), world.diskReads(),
+           world.movementBlocks(), world.movementBlocksSkipped(), 100.0 * world.awakeShare(), 100.0 * world.parkedShare(), conserved ? "yes" : "no");
     std::filesystem::remove_all(dir);
     return conserved ? 0 : 2;
 }
 
+// Movement-only timing of the two sub-pass schedules on a resident seedMat window:
+// pass-major (16 full sweeps per frame) vs fused (all 16 sweeps advanced band by band
+// through a cache-sized row band), and of the bitplane step. All must leave a
+// bit-identical grid. Reactions are skipped -- this isolates the memory traffic the
+// fused schedule removes.
+static void runMoveBench(int steps) {
+    static const int sizes[][2] = {{4, 4}, {8, 6}, {16, 12}};
+    const StepFn fns[3] = {selectStep(), selectFusedStep(), selectPlaneStep()};
+    for (const auto& sz : sizes) {
+        int LW = sz[0] * CHUNK, LH = sz[1] * CHUNK, SW = gridStride(LW, PAD), SH = LH + 2 * PAD;
+        std::vector<uint8_t> init((size_t)SW * SH, WALL);
+        for (int y = 0; y < LH; ++y)
+            for (int x = 0; x < LW; ++x) init[(size_t)(y + PAD) * SW + x + PAD] = seedMat(x, y);
+        GridBuffer grid[3], moved;                     // laid out as SimdWorld's
+        for (GridBuffer& g : grid) {
+            g.assign(init.size(), 0, PAD);
+            std::memcpy(g.data(), init.data(), init.size());
+        }
+        moved.assign(movedBytes(SW, SH), 0, PAD);
+        MatMask mats;                                  // movement makes no new materials
+        for (uint8_t m : init) mats.add(m);
+        double ms[3];
+        for (int k = 0; k < 3; ++k) {
+            StepFn fn = fns[k];
+            auto t0 = std::chrono::steady_clock::now();
+            for (int s = 0; s < steps; ++s)
+                fn(grid[k].data(), moved.data(), SW, PAD, PAD + LW, PAD, PAD + LH, (uint32_t)s, specialisedMove() ? mats.w : nullptr);
+            ms[k] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        }
+        printf("MOVE impl=cpp_%s window=%dx%d steps=%d passes_ms=%.3f fused_ms=%.3f planes_ms=%.3f "
+               "speedup=%.2fx identical=%s\n", simdName(), sz[0], sz[1], steps, ms[0], ms[1], ms[2],
+               ms[1] > 0.0 ? ms[0] / ms[1] : 0.0, !std::memcmp(grid[0].data(), grid[1].data(), init.size()) && !std::memcmp(grid[0].data(), grid[2].data(), init.size()) ? "yes" : "no");
+    }
+}
+
+// SANDSIM_TEMPORAL=K: the whole frame (movement and reactions) on windows of growing
+// size, stepped one frame per call and K frames per call (stepAhead()), from the same
+// world. Both must end bit-identical; sleeping is off in both.
+static void runTemporalBench(int steps, int K) {
+    static const int sizes[][2] = {{4, 4}, {16, 12}, {32, 24}};
+    steps -= steps % K;
+    for (const auto& sz : sizes) {
+        double ms[2];
+        uint64_t ck[2], cnt[MATERIAL_COUNT];
+        for (int v = 0; v < 2; ++v) {
+            const std::string dir = "/tmp/sandsim_world_temporal_" + std::to_string(sz[0]) + "x" + std::to_string(sz[1]);
+            std::filesystem::remove_all(dir);
+            {
+                SimdWorld world(sz[0], sz[1], sz[0], sz[1], dir);
+                world.generateAllToDisk();
+                world.setWindow(0, 0);
+                auto t0 = std::chrono::steady_clock::now();
+                for (int s = 0; s < steps; s += v ? K : 1) world.step(v ? K : 1);
+                ms[v] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+                world.summary(ck[v], cnt);
+            }
+            std::filesystem::remove_all(dir);
+        }
+        printf("TEMPORAL impl=cpp_%s window=%dx%d frames=%d steps=%d serial_ms=%.3f temporal_ms=%.3f "
+               "speedup=%.2fx identical=%s\n", simdName(), sz[0], sz[1], K, steps, ms[0], ms[1],
+               ms[1] > 0.0 ? ms[0] / ms[1] : 0.0, ck[0] == ck[1] ? "yes" : "no");
+    }
+}
+
 static int runPPM(const char* pathOut, int steps) {
     const int gw = 4, gh = 4;
     std::string dir = "/tmp/sandsim_world_simd_ppm";
@@ -601,12 +1807,25 @@ static int runInteractive(ViewCfg cfg) {
 }
 
 int main(int argc, char* argv[]) {
-    g_step = selectStep();   // pick AVX2 or SSE based on the running CPU
+    selectKernels();
+    if (const char* e = getenv("SANDSIM_THREADS")) g_threads = std::atoi(e);
+    for (int i = 1; i + 1 < argc; ++i)          // --threads N, anywhere; drop it from argv
+        if (!std::strcmp(argv[i], "--threads")) {
+            g_threads = std::atoi(argv[i + 1]);
+            for (int j = i; j + 2 <= argc; ++j) argv[j] = argv[j + 2];
+            argc -= 2;
+            break;
+        }
+    if (g_threads < 1) g_threads = 1;
     if (argc > 1 && std::strcmp(argv[1], "--bench") == 0) {
         int steps = (argc > 2) ? std::atoi(argv[2]) : 600;
         int wbox  = (argc > 3) ? std::atoi(argv[3]) : 6;
         int hbox  = (argc > 4) ? std::atoi(argv[4]) : 6;
-        return runBench(steps, wbox, hbox);
+        const GridLayout layout = argc > 5 && !std::strcmp(argv[5], "tiles") ? GridLayout::Tiles : GridLayout::Rows;
+        int rc = runBench(steps, wbox, hbox, layout);
+        runMoveBench(steps < 200 ? steps : 200);
+        if (temporalFrames() > 1) runTemporalBench(steps < 120 ? steps : 120, temporalFrames());
+        return rc;
     }
     if (argc > 2 && std::strcmp(argv[1], "--ppm") == 0) {
         int steps = (argc > 3) ? std::atoi(argv[3]) : 400;
@@ -614,3 +1833,4 @@ int main(int argc, char* argv[]) {
     }
     return runInteractive(parseView(argc, argv));
 }
+#endif
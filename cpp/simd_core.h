@@ -1,5 +1,5 @@
 // Shared multi-material falling-sand update, parameterised over the SIMD width
-// (SSE = 16 lanes, AVX2 = 32 lanes). The same rule is implemented by the GPU
+// (SSE = 16 lanes, AVX2 = 32 lanes, AVX-512BW = 64 lanes). The same rule is implemented by the GPU
 // compute shaders so all backends produce a bit-identical world.
 //
 // The rule is ORDER-INDEPENDENT: each frame is a fixed sequence of sub-passes,
@@ -19,19 +19,35 @@
 //   per-cell time-varying pass in materials.h, kept out of this movement step.)
 #pragma once
 #include "materials.h"
+#include "world_step.h"  // StepBand
 #include <emmintrin.h>
 #include <smmintrin.h>   // SSE4.1
-#include <immintrin.h>   // AVX2
+#include <immintrin.h>   // AVX2 / AVX-512BW
 #include <cstdint>
 #include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
 
 enum SimdGroup { SG_DOWN, SG_GAS, SG_HORIZ };  // which materials move in a pass
 
+// Each Ops policy has a vector type V (W cells) and a lane-mask type M. On SSE/AVX2 a
+// mask is itself a vector of 0x00/0xFF bytes (M == V); on AVX-512 it is an opmask
+// register, one bit per lane. load/store need a W-byte aligned address, loadu/storeu
+// take any. eq/And/Or/blend/shr1/shl1 and the lane-pattern constants work on M.
+// shuffle/addsu8/Xor/bcast16/testnz drive the table classifier (see MoveLut);
+// testz/select read and set a bit of the packed `moved` plane (movedRow()), and orAll
+// ORs a vector's bytes together (the span summaries, see SpanSum). add (wrapping) and
+// leu (unsigned <=) evaluate the reactions' frame hashes (simd_react.h); bits/lanes
+// turn a lane mask into one bit per lane and back (its bit-sliced automata).
 struct SseOps {
     using V = __m128i;
+    using M = V;
     static constexpr int W = 16;
     static V loadu(const uint8_t* p) { return _mm_loadu_si128((const V*)p); }
     static void storeu(uint8_t* p, V v) { _mm_storeu_si128((V*)p, v); }
+    static V load(const uint8_t* p) { return _mm_load_si128((const V*)p); }
+    static void store(uint8_t* p, V v) { _mm_store_si128((V*)p, v); }
     static V set1(int b) { return _mm_set1_epi8((char)b); }
     static V zero() { return _mm_setzero_si128(); }
     static V eq(V a, V b) { return _mm_cmpeq_epi8(a, b); }
@@ -45,14 +61,34 @@ struct SseOps {
     static V odd()  { return _mm_set_epi8(-1,0,-1,0,-1,0,-1,0,-1,0,-1,0,-1,0,-1,0); }
     static V notStart() { return _mm_set_epi8(-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,0); }
     static V notEnd()   { return _mm_set_epi8(0,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1); }
+    static V Xor(V a, V b) { return _mm_xor_si128(a, b); }
+    static V addsu8(V a, V b) { return _mm_adds_epu8(a, b); }
+    static V shuffle(V tbl, V idx) { return _mm_shuffle_epi8(tbl, idx); }
+    static V bcast16(const uint8_t* p) { return _mm_loadu_si128((const V*)p); }
+    static M testnz(V a, V b) { return _mm_xor_si128(_mm_cmpeq_epi8(_mm_and_si128(a, b), zero()), ones()); }
+    static M testz(V a, V b) { return _mm_cmpeq_epi8(_mm_and_si128(a, b), zero()); }
+    static V select(M m, V v) { return _mm_and_si128(m, v); }
+    static V add(V a, V b) { return _mm_add_epi8(a, b); }
+    static M leu(V a, V b) { return _mm_cmpeq_epi8(_mm_min_epu8(a, b), a); }
+    static uint8_t orAll(V v) { return foldOr((uint64_t)_mm_cvtsi128_si64(_mm_or_si128(v, _mm_unpackhi_epi64(v, v)))); }
+    static uint8_t foldOr(uint64_t q) { q |= q >> 32; q |= q >> 16; q |= q >> 8; return (uint8_t)q; }
+    static uint64_t bits(M m) { return (uint16_t)_mm_movemask_epi8(m); }
+    static M lanes(uint64_t b) {                 // lane l <- bit l of b
+        const V v = _mm_shuffle_epi8(_mm_set1_epi16((short)b), _mm_set_epi8(1,1,1,1,1,1,1,1,0,0,0,0,0,0,0,0));
+        const V bit = _mm_set1_epi64x((long long)0x8040201008040201ull);
+        return _mm_cmpeq_epi8(_mm_and_si128(v, bit), bit);
+    }
 };
 
 #ifdef __AVX2__
 struct AvxOps {
     using V = __m256i;
+    using M = V;
     static constexpr int W = 32;
     static V loadu(const uint8_t* p) { return _mm256_loadu_si256((const V*)p); }
     static void storeu(uint8_t* p, V v) { _mm256_storeu_si256((V*)p, v); }
+    static V load(const uint8_t* p) { return _mm256_load_si256((const V*)p); }
+    static void store(uint8_t* p, V v) { _mm256_store_si256((V*)p, v); }
     static V set1(int b) { return _mm256_set1_epi8((char)b); }
     static V zero() { return _mm256_setzero_si256(); }
     static V eq(V a, V b) { return _mm256_cmpeq_epi8(a, b); }
@@ -70,136 +106,493 @@ struct AvxOps {
                                                   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,0); }
     static V notEnd()   { return _mm256_set_epi8(0,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
                                                   0,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1); }
+    static V Xor(V a, V b) { return _mm256_xor_si256(a, b); }
+    static V addsu8(V a, V b) { return _mm256_adds_epu8(a, b); }
+    static V shuffle(V tbl, V idx) { return _mm256_shuffle_epi8(tbl, idx); }   // per-128 lane
+    static V bcast16(const uint8_t* p) { return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)p)); }
+    static M testnz(V a, V b) { return _mm256_xor_si256(_mm256_cmpeq_epi8(_mm256_and_si256(a, b), zero()), ones()); }
+    static M testz(V a, V b) { return _mm256_cmpeq_epi8(_mm256_and_si256(a, b), zero()); }
+    static V select(M m, V v) { return _mm256_and_si256(m, v); }
+    static V add(V a, V b) { return _mm256_add_epi8(a, b); }
+    static M leu(V a, V b) { return _mm256_cmpeq_epi8(_mm256_min_epu8(a, b), a); }
+    static uint8_t orAll(V v) { return SseOps::orAll(_mm_or_si128(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1))); }
+    static uint64_t bits(M m) { return (uint32_t)_mm256_movemask_epi8(m); }
+    static M lanes(uint64_t b) {
+        const V v = _mm256_shuffle_epi8(_mm256_set1_epi32((int)b),
+                                        _mm256_set_epi8(3,3,3,3,3,3,3,3,2,2,2,2,2,2,2,2, 1,1,1,1,1,1,1,1,0,0,0,0,0,0,0,0));
+        const V bit = _mm256_set1_epi64x((long long)0x8040201008040201ull);
+        return _mm256_cmpeq_epi8(_mm256_and_si256(v, bit), bit);
+    }
 };
 #endif
 
-template <class Ops>
-inline void simdStep(uint8_t* grid, uint8_t* moved, int SW,
-                     int X0, int X1, int Y0, int Y1, uint32_t /*frame*/) {
+#ifdef __AVX512BW__
+// 64 lanes with native opmasks: compares write a k-register, the Or/And chains run on
+// masks, and blends are a single masked move -- no 0xFF byte masks and no blendv. The
+// byte shifts stay per-128-bit lane like AVX2, so the horizontal pass keeps the same
+// 16-cell group boundaries (and the same result); the mask shifts mirror that exactly.
+struct Avx512Ops {
+    using V = __m512i;
+    using M = __mmask64;
+    static constexpr int W = 64;
+    static V loadu(const uint8_t* p) { return _mm512_loadu_si512((const void*)p); }
+    static void storeu(uint8_t* p, V v) { _mm512_storeu_si512((void*)p, v); }
+    static V load(const uint8_t* p) { return _mm512_load_si512((const void*)p); }
+    static void store(uint8_t* p, V v) { _mm512_store_si512((void*)p, v); }
+    static V set1(int b) { return _mm512_set1_epi8((char)b); }
+    static V zero() { return _mm512_setzero_si512(); }
+    static M eq(V a, V b) { return _mm512_cmpeq_epi8_mask(a, b); }
+    static M And(M a, M b) { return a & b; }
+    static M Or(M a, M b) { return a | b; }
+    static V blend(V a, V b, M m) { return _mm512_mask_blend_epi8(m, a, b); }
+    static V shr1(V a) { return _mm512_bsrli_epi128(a, 1); }   // per-128 lane
+    static V shl1(V a) { return _mm512_bslli_epi128(a, 1); }
+    static M shr1(M m) { return (m >> 1) & ~0x8000800080008000ull; }   // lane 15 of each group <- 0
+    static M shl1(M m) { return (m << 1) & ~0x0001000100010001ull; }   // lane 0 of each group <- 0
+    static M ones() { return ~0ull; }
+    static M even() { return 0x5555555555555555ull; }
+    static M odd()  { return 0xAAAAAAAAAAAAAAAAull; }
+    static M notStart() { return ~0x0001000100010001ull; }
+    static M notEnd()   { return ~0x8000800080008000ull; }
+    static V Or(V a, V b) { return _mm512_or_si512(a, b); }
+    static V Xor(V a, V b) { return _mm512_xor_si512(a, b); }
+    static V addsu8(V a, V b) { return _mm512_adds_epu8(a, b); }
+    static V shuffle(V tbl, V idx) { return _mm512_shuffle_epi8(tbl, idx); }   // per-128 lane
+    static V bcast16(const uint8_t* p) { return _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_loadu_si128((const __m128i*)p)); }
+    static M testnz(V a, V b) { return _mm512_test_epi8_mask(a, b); }
+    static M testz(V a, V b) { return _mm512_testn_epi8_mask(a, b); }
+    static V select(M m, V v) { return _mm512_maskz_mov_epi8(m, v); }
+    static V add(V a, V b) { return _mm512_add_epi8(a, b); }
+    static M leu(V a, V b) { return _mm512_cmple_epu8_mask(a, b); }
+    static uint8_t orAll(V v) {
+        __m256i h = _mm256_or_si256(_mm512_maskz_extracti64x4_epi64(0xF, v, 0), _mm512_maskz_extracti64x4_epi64(0xF, v, 1));
+        return SseOps::orAll(_mm_or_si128(_mm256_castsi256_si128(h), _mm256_extracti128_si256(h, 1)));
+    }
+    static uint64_t bits(M m) { return m; }
+    static M lanes(uint64_t b) { return b; }
+};
+#endif
+
+// ---------------------------------------------------------------------------
+// Movement classes: one compile-time row per material, the single description of
+// the density rule that the SIMD classifier below is generated from.
+//   sink / under : a sinking mover enters any target whose `under` tier is strictly
+//                  below its `sink` tier (0 = never sinks, NO_TIER = never entered).
+//                  Density MERCURY > SAND (+ heavy powders) > LAVA > ACID > WATER/NITRO
+//                  > OIL/CRYO > SNOW/FUMES/CHLORINE > air + light gases.
+//   rise / over  : the same for rising movers -- GAS/FIRE/STEAM/SMOKE/LEVITON rise into
+//                  air only, WISP (the lightest) rises through every liquid and gas too.
+//   groups       : which of the SG_DOWN / SG_GAS / SG_HORIZ passes the mover takes part in.
+// A mover may enter a target when (under[t] < sink[m]) || (over[t] < rise[m]).
+static constexpr uint8_t NO_TIER = 15;
+enum : uint8_t { MG_DOWN = 1u << SG_DOWN, MG_GAS = 1u << SG_GAS, MG_HORIZ = 1u << SG_HORIZ };
+struct MoveClass { uint8_t sink, under, rise, over, groups; };
+constexpr MoveClass moveClass(int m) {
+    switch (m) {
+        case EMPTY:      return {0, 1, 0, 1, 0};
+        case GAS: case FIRE: case STEAM: case SMOKE:
+                         return {0, 1, 2, 2, MG_GAS | MG_HORIZ};
+        case LEVITON:    return {0, 1, 2, 2, MG_GAS};                  // rises + diag-up, NOT horiz
+        case WISP:       return {0, NO_TIER, 3, NO_TIER, MG_GAS | MG_HORIZ};
+        case SNOW:       return {2, 2, 0, NO_TIER, MG_DOWN};           // light powder: floats on liquids
+        case FUMES: case CHLORINE:
+                         return {2, 2, 0, NO_TIER, MG_DOWN | MG_HORIZ}; // heavy gases sink and pool
+        case OIL: case CRYO:
+                         return {3, 3, 0, 2, MG_DOWN | MG_HORIZ};
+        case WATER: case NITRO:
+                         return {4, 4, 0, 2, MG_DOWN | MG_HORIZ};
+        case ACID:       return {5, 5, 0, 2, MG_DOWN | MG_HORIZ};
+        case LAVA:       return {6, 6, 0, 2, MG_DOWN | MG_HORIZ};
+        case SAND:       return {7, 7, 0, NO_TIER, MG_DOWN};
+        case ASH: case GUNPOWDER: case THERMITE: case COAL: case EMBER: case LYE: case SODIUM:
+        case PHOSPHORUS: case CEMENT: case IRON: case RUST: case SEED:
+                         return {7, NO_TIER, 0, NO_TIER, MG_DOWN};     // heavy powders pile like sand
+        case MERCURY:    return {8, NO_TIER, 0, 2, MG_DOWN | MG_HORIZ}; // heaviest: sinks through SAND too
+        default:         return {0, NO_TIER, 0, NO_TIER, 0};           // solids never move or give way
+    }
+}
+constexpr bool canEnter(int m, int t) {
+    return moveClass(t).under < moveClass(m).sink || moveClass(t).over < moveClass(m).rise;
+}
+
+// Per-group byte tables for the vector classifier. Within one group every eligible
+// mover has one of at most 8 distinct target sets, so mover[m] is the one-hot bit of
+// its set (0 if it doesn't move in this group) and target[t] has a bit for every set
+// that t belongs to: `can` is then simply (mover[cur] & target[tgt]) != 0. Ids past
+// MATERIAL_COUNT stay 0. Adding a material only edits moveClass() -- the kernel cost
+// grows per 16 ids (one more shuffle), not per material.
+static constexpr int LUT_GROUPS = (MATERIAL_COUNT + 15) / 16;
+struct MoveLut { uint8_t mover[16 * LUT_GROUPS]; uint8_t target[16 * LUT_GROUPS]; int classes; };
+constexpr MoveLut buildMoveLut(int grp) {
+    MoveLut L{};
+    uint8_t sinkOf[9] = {}, riseOf[9] = {};
+    for (int m = 0; m < MATERIAL_COUNT; ++m) {
+        MoveClass c = moveClass(m);
+        if (!(c.groups & (1u << grp))) continue;
+        int b = 0;
+        while (b < L.classes && !(sinkOf[b] == c.sink && riseOf[b] == c.rise)) ++b;
+        if (b == L.classes && L.classes < 9) { sinkOf[b] = c.sink; riseOf[b] = c.rise; ++L.classes; }
+        L.mover[m] = (uint8_t)(1u << b);
+    }
+    for (int t = 0; t < MATERIAL_COUNT; ++t)
+        for (int b = 0; b < L.classes && b < 8; ++b)
+            if (moveClass(t).under < sinkOf[b] || moveClass(t).over < riseOf[b]) L.target[t] |= (uint8_t)(1u << b);
+    return L;
+}
+static constexpr MoveLut kMoveLut[3] = { buildMoveLut(SG_DOWN), buildMoveLut(SG_GAS), buildMoveLut(SG_HORIZ) };
+static_assert(kMoveLut[SG_DOWN].classes <= 8 && kMoveLut[SG_GAS].classes <= 8 && kMoveLut[SG_HORIZ].classes <= 8,
+              "a movement group needs more than 8 distinct target sets; widen the classifier");
+
+// The table banks a window's materials need: up to the last bank holding one of them
+// with a nonzero byte in some table. Every other id classifies as 0 whether its bank
+// is read or not, so the classifier may stop there. `mats` are MatMask words
+// (nullptr: every bank).
+inline int moveBanks(const uint64_t* mats) {
+    if (!mats) return LUT_GROUPS;
+    int banks = 1;
+    for (int m = 16; m < MATERIAL_COUNT; ++m) {
+        if (!((mats[m >> 6] >> (m & 63)) & 1)) continue;
+        for (int g = 0; g < 3; ++g)
+            if (kMoveLut[g].mover[m] | kMoveLut[g].target[m]) banks = m / 16 + 1;
+    }
+    return banks;
+}
+
+// The frame's fixed sub-pass sequence, described the way the GPU backends push it:
+// type 0 = vertical (row parity), 1 = diagonal, 2 = horizontal (column parity, 0 = even).
+struct SubPass { int8_t type, dx, dy, parity, grp; };
+static constexpr int SUBPASSES = 16;
+static constexpr SubPass kSubPasses[SUBPASSES] = {
+    {0,  0,  1, 0, SG_DOWN},  {0,  0,  1, 1, SG_DOWN},              // sand/water fall
+    {1, -1,  1, 0, SG_DOWN},  {1, -1,  1, 1, SG_DOWN},              // ... down-left
+    {1,  1,  1, 0, SG_DOWN},  {1,  1,  1, 1, SG_DOWN},              // ... down-right
+    {0,  0, -1, 0, SG_GAS},   {0,  0, -1, 1, SG_GAS},               // gas rises
+    {1, -1, -1, 0, SG_GAS},   {1, -1, -1, 1, SG_GAS},               // ... up-left
+    {1,  1, -1, 0, SG_GAS},   {1,  1, -1, 1, SG_GAS},               // ... up-right
+    {2, -1,  0, 0, SG_HORIZ}, {2, -1,  0, 1, SG_HORIZ},             // water/gas spread left
+    {2,  1,  0, 0, SG_HORIZ}, {2,  1,  0, 1, SG_HORIZ},             // ... and right
+};
+static_assert(SUBPASSES == STEP_SUBPASSES, "world_step.h's sub-pass count (task scheduling) is stale");
+static constexpr int SUBPASS_LAG = 2;           // rows each sub-pass trails the previous one when fused
+static constexpr size_t FUSE_BAND_BYTES = 512 * 1024;   // grid + moved bytes per fused band (~half an L2)
+
+// Rows per fused band for a padded stride: FUSE_BAND_BYTES of grid+moved, less the
+// rows the 16 lagging sub-passes are spread across.
+inline int fusedBandRows(int SW) {
+    int rows = (int)(FUSE_BAND_BYTES / ((size_t)SW + SW / 8)) - SUBPASS_LAG * SUBPASSES;
+    return rows < 8 ? 8 : rows;
+}
+
+// Span summaries (SpanSum, in world_step.h so a scheduler can hold a chunk's between
+// tasks): a block can only move if some source cell's mover class meets some target
+// cell's target class, so (source span mover & target span target) == 0 proves the
+// whole block inert -- solid rock, open sky, a settled pile -- and it is skipped
+// without touching the grid.
+
+// One movement frame. bandRows <= 0 runs the 16 sub-passes as 16 full sweeps;
+// bandRows > 0 runs them fused over bands of that many rows (same result). With a
+// `band`, runs one worker's rows of a multi-threaded frame (see StepBand); with a
+// `task`, one pass of one chunk (see StepTask). Returns the number of W-lane blocks
+// the span summaries let it skip. The classifier reads the first `Banks` table banks.
+template <class Ops, int Banks = LUT_GROUPS>
+inline uint64_t simdStep(uint8_t* grid, uint8_t* moved, int SW,
+                         int X0, int X1, int Y0, int Y1, uint32_t /*frame*/, int bandRows = 0,
+                         const StepBand* band = nullptr, const StepTask* task = nullptr) {
     using V = typename Ops::V;
+    using M = typename Ops::M;
     const int W = Ops::W;
-    const V vE = Ops::zero(), vS = Ops::set1(SAND), vW = Ops::set1(WATER),
-            vG = Ops::set1(GAS), vO = Ops::set1(OIL), vF = Ops::set1(FIRE), vL = Ops::set1(LAVA),
-            vSt = Ops::set1(STEAM), vA = Ops::set1(ACID), vSm = Ops::set1(SMOKE), vAsh = Ops::set1(ASH),
-            vSnow = Ops::set1(SNOW), vMerc = Ops::set1(MERCURY), vGun = Ops::set1(GUNPOWDER),
-            vTh = Ops::set1(THERMITE), vWisp = Ops::set1(WISP),
-            vCoal = Ops::set1(COAL), vEmber = Ops::set1(EMBER), vFumes = Ops::set1(FUMES),
-            vLye = Ops::set1(LYE), vSodium = Ops::set1(SODIUM), vPhos = Ops::set1(PHOSPHORUS),
-            vCement = Ops::set1(CEMENT), vChlor = Ops::set1(CHLORINE), vCryo = Ops::set1(CRYO),
-            vLev = Ops::set1(LEVITON), vIron = Ops::set1(IRON), vNitro = Ops::set1(NITRO),
-            vRust = Ops::set1(RUST), vSeed = Ops::set1(SEED);
+    const V v70 = Ops::set1(0x70);
+    // `moved` is bit-packed 8 rows deep (see world_step.h): row y's flags are bit
+    // y%8 of the W bytes at column x of packed row y/8.
+    auto movedRow = [&](int y) { return moved + (size_t)(y >> 3) * SW; };
+    auto rowBit = [&](int y) { return Ops::set1(1 << (y & 7)); };
+
+    // Classify a block by table lookup: pshufb resolves 16 ids per shuffle, so one
+    // shuffle per 16-id bank. A lane's id is steered into bank g as (id ^ 16g) +sat 0x70,
+    // which lands in 0x70..0x7F only for ids in the bank -- every other lane gets bit 7
+    // set and the shuffle zeroes it.
+    struct Cls { V mover[Banks], target[Banks]; };
+    Cls cls[3];
+    for (int g = 0; g < 3; ++g)
+        for (int b = 0; b < Banks; ++b) {
+            cls[g].mover[b]  = Ops::bcast16(&kMoveLut[g].mover[16 * b]);
+            cls[g].target[b] = Ops::bcast16(&kMoveLut[g].target[16 * b]);
+        }
+    auto lookup = [&](V id, const V* tbl) -> V {
+        V r = Ops::shuffle(tbl[0], Ops::addsu8(id, v70));
+        for (int b = 1; b < Banks; ++b)
+            r = Ops::Or(r, Ops::shuffle(tbl[b], Ops::addsu8(Ops::Xor(id, Ops::set1(16 * b)), v70)));
+        return r;
+    };
+
+    // Span summaries for rows Y0-1 .. Y1 (every row a pass reads), built from each
+    // row's content before any sub-pass touches it. They need no upkeep during the
+    // frame: a swap only creates a new mover/target combination in cells it also
+    // marks moved, and moved cells take no further part this frame. Spans cover the
+    // blocks' lanes [X0, XB); the halo columns a diagonal reaches (X0-1 and XB) are
+    // folded into the end spans.
+    // A band worker keeps its own summaries, of its rows and the one on either side;
+    // a chunk task keeps them in the scheduler's buffer from its prepare task on.
+    const int nBlocks = (X1 - X0 + W - 1) / W, XB = X0 + nBlocks * W;
+    const int nSpans = (XB - X0 + SPAN - 1) / SPAN;
+    const int sy0 = (band ? band->ya : Y0) - 1, sy1 = (band ? band->yb : Y1) + 1;
+    std::vector<SpanSum> ownSpans(task ? 0 : (size_t)(sy1 - sy0) * nSpans);
+    SpanSum* spans = task ? task->spans : ownSpans.data();
+    auto spanRow = [&](int y) { return &spans[(size_t)(y - sy0) * nSpans]; };
+    auto buildSpans = [&](int ya, int yb) {
+        for (int y = ya; y < yb; ++y) {
+            const uint8_t* row = grid + (size_t)y * SW;
+            SpanSum* out = spanRow(y);
+            for (int s = 0; s < nSpans; ++s) {
+                const int xa = X0 + s * SPAN, xb = std::min(XB, X0 + (s + 1) * SPAN);
+                // Most inert spans are one material (rock, air, a pool): detect that
+                // with a xor and read the summary straight from the tables.
+                const uint8_t id = row[xa];
+                V diff = Ops::zero();
+                for (int x = xa; x < xb; x += W) diff = Ops::Or(diff, Ops::Xor(Ops::loadu(row + x), Ops::set1(id)));
+                if (Ops::orAll(diff) == 0) {
+                    for (int g = 0; g < 3; ++g) { out[s].mover[g] = kMoveLut[g].mover[id]; out[s].target[g] = kMoveLut[g].target[id]; }
+                    continue;
+                }
+                V accM[3] = {Ops::zero(), Ops::zero(), Ops::zero()}, accT[3] = {accM[0], accM[0], accM[0]};
+                for (int x = xa; x < xb; x += W) {
+                    V cur = Ops::loadu(row + x);
+                    for (int g = 0; g < 3; ++g) {
+                        accM[g] = Ops::Or(accM[g], lookup(cur, cls[g].mover));
+                        accT[g] = Ops::Or(accT[g], lookup(cur, cls[g].target));
+                    }
+                }
+                for (int g = 0; g < 3; ++g) { out[s].mover[g] = Ops::orAll(accM[g]); out[s].target[g] = Ops::orAll(accT[g]); }
+            }
+            for (int g = 0; g < 3; ++g) {
+                out[0].mover[g] |= kMoveLut[g].mover[row[X0 - 1]];
+                out[0].target[g] |= kMoveLut[g].target[row[X0 - 1]];
+                out[nSpans - 1].mover[g] |= kMoveLut[g].mover[row[XB]];
+                out[nSpans - 1].target[g] |= kMoveLut[g].target[row[XB]];
+            }
+        }
+    };
+    // The blocks of row y that can move anything to (y+dy, x+dx) in group g, listed
+    // into liveX up front (branch-free) so the swap loops run without a per-block
+    // test. A block's target lanes may straddle two spans; span indices past either
+    // end land on the end spans.
+    // A chunk task keeps these lists, and swapRow()'s move masks, in its worker's
+    // StepTask::blocks; the other callers allocate their own once per call.
+    struct MaskSlot { M m; };
+    static_assert(sizeof(MaskSlot) <= 64 && alignof(MaskSlot) <= 64, "stepBlockBytes() is too small");
+    uint64_t skipped = 0;
+    std::vector<int> ownLive(task ? 0 : (size_t)nBlocks);
+    std::vector<MaskSlot> ownMask(task ? 0 : (size_t)nBlocks);
+    MaskSlot* const rowMask = task ? reinterpret_cast<MaskSlot*>(task->blocks) : ownMask.data();
+    int* const liveX = task ? reinterpret_cast<int*>(task->blocks + (size_t)nBlocks * sizeof(MaskSlot)) : ownLive.data();
+    auto liveBlocks = [&](int y, int dx, int dy, int g) -> int {
+        const SpanSum* src = spanRow(y);
+        const SpanSum* tgt = spanRow(y + dy);
+        int* out = liveX;
+        int n = 0;
+        for (int b = 0; b < nBlocks; ++b) {
+            int x = b * W;
+            int t0 = std::max(0, (x + dx) / SPAN), t1 = std::min(nSpans - 1, (x + dx + W - 1) / SPAN);
+            out[n] = X0 + x;
+            n += (src[x / SPAN].mover[g] & (tgt[t0].target[g] | tgt[t1].target[g])) != 0;
+        }
+        skipped += (uint64_t)(nBlocks - n);
+        return n;
+    };
 
     // move mask: which lanes hold an eligible mover whose target is enterable and
-    // where neither cell has already moved this frame. Density SAND>LAVA>ACID>
-    // WATER>OIL>air>GAS>FIRE/STEAM: a mover can swap into anything strictly lighter.
-    auto mask = [&](V cur, V tgt, V mc, V mt, int grp) -> V {
-        V isS = Ops::eq(cur, vS), isW = Ops::eq(cur, vW), isG = Ops::eq(cur, vG),
-          isO = Ops::eq(cur, vO), isF = Ops::eq(cur, vF), isL = Ops::eq(cur, vL),
-          isSt = Ops::eq(cur, vSt), isA = Ops::eq(cur, vA), isSm = Ops::eq(cur, vSm),
-          isAsh = Ops::eq(cur, vAsh), isSnow = Ops::eq(cur, vSnow), isMerc = Ops::eq(cur, vMerc),
-          isGun = Ops::eq(cur, vGun), isTh = Ops::eq(cur, vTh), isWisp = Ops::eq(cur, vWisp),
-          isCoal = Ops::eq(cur, vCoal), isEmber = Ops::eq(cur, vEmber), isFumes = Ops::eq(cur, vFumes),
-          isLye = Ops::eq(cur, vLye), isSodium = Ops::eq(cur, vSodium), isPhos = Ops::eq(cur, vPhos),
-          isCement = Ops::eq(cur, vCement), isChlor = Ops::eq(cur, vChlor), isCryo = Ops::eq(cur, vCryo),
-          isLev = Ops::eq(cur, vLev), isIron = Ops::eq(cur, vIron), isNitro = Ops::eq(cur, vNitro),
-          isRust = Ops::eq(cur, vRust), isSeed = Ops::eq(cur, vSeed);
-        V tE = Ops::eq(tgt, vE), tW = Ops::eq(tgt, vW), tG = Ops::eq(tgt, vG),
-          tO = Ops::eq(tgt, vO), tF = Ops::eq(tgt, vF), tL = Ops::eq(tgt, vL),
-          tSt = Ops::eq(tgt, vSt), tA = Ops::eq(tgt, vA), tSm = Ops::eq(tgt, vSm),
-          tSnow = Ops::eq(tgt, vSnow), tS = Ops::eq(tgt, vS), tMerc = Ops::eq(tgt, vMerc),
-          tFumes = Ops::eq(tgt, vFumes), tChlor = Ops::eq(tgt, vChlor), tCryo = Ops::eq(tgt, vCryo),
-          tLev = Ops::eq(tgt, vLev), tNitro = Ops::eq(tgt, vNitro);
-        V lightGas   = Ops::Or(Ops::Or(Ops::Or(tG, tF), Ops::Or(tSt, Ops::Or(tSm, tE))), tLev);  // G,F,STEAM,SMOKE,E,LEVITON (everything heavier sinks through anti-grav dust)
-        V lightSnow  = Ops::Or(lightGas, Ops::Or(Ops::Or(tSnow, tFumes), tChlor));          // SNOW/FUMES/CHLORINE tier + light (heavier than air, float on liquids)
-        V belowAcid  = Ops::Or(Ops::Or(Ops::Or(Ops::Or(tW, tO), tCryo), tNitro), lightSnow); // W,O,CRYO,NITRO,SNOW,+light
-        V belowSand  = Ops::Or(Ops::Or(tL, tA), belowAcid);                                 // L,A,W,O,SNOW,+light
-        V belowLava  = Ops::Or(tA, belowAcid);                                              // A,W,O,SNOW,+light
-        V belowWater = Ops::Or(Ops::Or(tO, tCryo), lightSnow);                              // O,CRYO,SNOW,+light
-        V belowNitro = belowWater;                                                          // NITRO (liquid explosive): water-density, floods like water
-        V belowOil   = lightSnow;                                                           // SNOW,G,F,STEAM,SMOKE,E
-        V belowCryo  = lightSnow;                                                           // CRYO (cold liquid, same tier as OIL): floats on water, sinks through snow/gases
-        V belowSnow  = lightGas;                                                            // SNOW floats on liquids: enters only G,F,St,Sm,E
-        V belowFumes = lightGas;                                                            // FUMES (heavy gas) sinks through air + lighter gases, floats on liquids
-        V belowChlor = lightGas;                                                            // CHLORINE (heavy gas, same tier as FUMES) sinks through air + lighter gases
-        V belowMerc  = Ops::Or(tS, belowSand);                                              // MERCURY is heaviest: sinks through SAND + everything
-        V aboveWisp  = Ops::Or(lightGas, Ops::Or(Ops::Or(Ops::Or(Ops::Or(tW, tO), tCryo), tNitro), Ops::Or(tA, Ops::Or(tL, tMerc))));  // WISP is lightest: rises through every liquid + gas + air
-        V rise = Ops::Or(isG, Ops::Or(isF, Ops::Or(isSt, Ops::Or(isSm, isWisp))));          // gas/fire/steam/smoke/wisp
-        V can = Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(
-            Ops::Or(Ops::And(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(isS, isAsh), isGun), isTh), isCoal), isEmber), isLye), isSodium), isPhos), isCement), isIron), isRust), isSeed), belowSand), Ops::And(isL, belowLava)),  // SAND/ASH/GUNPOWDER/THERMITE/COAL/EMBER/LYE/SODIUM/PHOSPHORUS/CEMENT/IRON/RUST/SEED: heavy powders
-            Ops::Or(Ops::Or(Ops::And(isA, belowAcid), Ops::And(isW, belowWater)), Ops::And(isNitro, belowNitro))),  // WATER / NITRO: water-density liquids
-            Ops::Or(Ops::Or(Ops::And(isO, belowOil), Ops::And(isCryo, belowCryo)), Ops::And(Ops::Or(rise, isLev), tE))),  // OIL / CRYO: light liquids; LEVITON rises into empty (up + diag-up)
-            Ops::And(isSnow, belowSnow)),                                                  // SNOW: light powder
-            Ops::And(isMerc, belowMerc)),                                                  // MERCURY: heaviest liquid
-            Ops::Or(Ops::And(isWisp, aboveWisp), Ops::Or(Ops::And(isFumes, belowFumes), Ops::And(isChlor, belowChlor))));  // WISP rises; FUMES/CHLORINE: heavy gases sink/pool
-        V elig = (grp == SG_DOWN) ? Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(isS, isAsh), isGun), isTh), isCoal), isEmber), isLye), isSodium), isPhos), isCement), isIron), isRust), isSeed), isSnow), isFumes), isChlor), isMerc), isL), Ops::Or(isA, Ops::Or(isW, Ops::Or(isO, Ops::Or(isCryo, isNitro)))))
-               : (grp == SG_GAS)  ? Ops::Or(rise, isLev)   // LEVITON rises + slides diagonally up (NOT horiz), so it piles inversely like sand
-                                  : Ops::Or(Ops::Or(Ops::Or(Ops::Or(Ops::Or(isL, isMerc), isA), isFumes), isChlor), Ops::Or(Ops::Or(isW, Ops::Or(isO, Ops::Or(isCryo, isNitro))), rise));
-        return Ops::And(Ops::And(elig, can),
-                        Ops::And(Ops::eq(mc, vE), Ops::eq(mt, vE)));
+    // where neither cell has already moved this frame (`free`; see moveClass()).
+    auto mask = [&](V cur, V tgt, M free, const Cls& c) -> M {
+        return Ops::And(Ops::testnz(lookup(cur, c.mover), lookup(tgt, c.target)), free);
     };
 
+    // Block loads and stores: aligned ones (A = std::true_type) where every vertical
+    // block is -- the host lays the grid and `moved` out so column X0 of every row
+    // starts a cache line -- so no block splits a line; unaligned ones otherwise.
+    const bool aligned = SW % W == 0 && ((uintptr_t)(grid + X0) | (uintptr_t)(moved + X0)) % W == 0;
+    auto ld = [](auto A, const uint8_t* p) -> V { if constexpr (decltype(A)::value) return Ops::load(p); else return Ops::loadu(p); };
+    auto st = [](auto A, uint8_t* p, V v) { if constexpr (decltype(A)::value) Ops::store(p, v); else Ops::storeu(p, v); };
+
     // Swap source (y,x..) with target (y+dy, x+dx..) for dy != 0 (different rows,
-    // so no same-row overlap). laneMask selects which columns may move.
-    auto swapBlock = [&](int y, int x, int dx, int dy, int grp, V laneMask) {
+    // so no same-row overlap). laneMask selects which columns may move. Returns the
+    // lanes that moved; swapRow sets their `moved` bits.
+    auto swapBlock = [&](auto A, int y, int x, int dx, int dy, const Cls& grp, M laneMask,
+                         const uint8_t* ms, V bs, const uint8_t* mt, V bt) -> M {
         uint8_t* gs = &grid[(size_t)y * SW + x];
         uint8_t* gt = &grid[(size_t)(y + dy) * SW + (x + dx)];
-        uint8_t* ms = &moved[(size_t)y * SW + x];
-        uint8_t* mt = &moved[(size_t)(y + dy) * SW + (x + dx)];
-        V cur = Ops::loadu(gs), tgt = Ops::loadu(gt), mc = Ops::loadu(ms), mtt = Ops::loadu(mt);
-        V m = Ops::And(mask(cur, tgt, mc, mtt, grp), laneMask);
-        Ops::storeu(gt, Ops::blend(tgt, cur, m));
-        Ops::storeu(gs, Ops::blend(cur, tgt, m));
-        Ops::storeu(mt, Ops::Or(mtt, m));
-        Ops::storeu(ms, Ops::Or(mc, m));
+        V cur = ld(A, gs), tgt = ld(A, gt);
+        M free = Ops::And(Ops::testz(ld(A, ms + x), bs), Ops::testz(ld(A, mt + x + dx), bt));
+        M m = Ops::And(mask(cur, tgt, free, grp), laneMask);
+        st(A, gt, Ops::blend(tgt, cur, m));
+        st(A, gs, Ops::blend(cur, tgt, m));
+        return m;
+    };
+
+    // One row of swapBlocks. A vertical pass sets each block's `moved` bits in-line
+    // (source and target share columns; within one packed row, one update sets both).
+    // A diagonal runs in two phases -- every block computes its moves, then the bits
+    // are set -- because its target bytes overlap the next block's source bytes in
+    // the packed row, and in-line updates would stall each block on a partly-
+    // overlapping store. No block reads a flag another block of the row sets
+    // (sources and targets are distinct cells), so both orders give the same result.
+    auto swapRow = [&](int y, int dx, int dy, int g, M laneMask) {
+        const Cls& c = cls[g];
+        uint8_t* ms = movedRow(y);
+        uint8_t* mt = movedRow(y + dy);
+        V bs = rowBit(y), bt = rowBit(y + dy);
+        const int n = liveBlocks(y, dx, dy, g);
+        const int* lx = liveX;
+        if (dx == 0) {
+            V b = (ms == mt) ? Ops::Or(bs, bt) : bs;
+            auto blocks = [&](auto A) {
+                for (int i = 0; i < n; ++i) {
+                    int x = lx[i];
+                    M m = swapBlock(A, y, x, 0, dy, c, laneMask, ms, bs, mt, bt);
+                    st(A, ms + x, Ops::Or(ld(A, ms + x), Ops::select(m, b)));
+                    if (ms != mt) st(A, mt + x, Ops::Or(ld(A, mt + x), Ops::select(m, bt)));
+                }
+            };
+            if (aligned) blocks(std::true_type{});
+            else         blocks(std::false_type{});
+            return;
+        }
+        MaskSlot* rm = rowMask;
+        for (int i = 0; i < n; ++i) rm[i].m = swapBlock(std::false_type{}, y, lx[i], dx, dy, c, laneMask, ms, bs, mt, bt);
+        for (int i = 0; i < n; ++i) Ops::storeu(ms + lx[i], Ops::Or(Ops::loadu(ms + lx[i]), Ops::select(rm[i].m, bs)));
+        for (int i = 0; i < n; ++i) { uint8_t* p = mt + lx[i] + dx; Ops::storeu(p, Ops::Or(Ops::loadu(p), Ops::select(rm[i].m, bt))); }
     };
 
     // Horizontal swap (dy=0, same row): the target lands inside the source
     // register, so use a 1-lane shift; skip the group-boundary lane so the
-    // per-128 AVX shift stays conserving.
-    auto horizBlock = [&](int y, int x, int dx, int grp, V laneMask) {
+    // per-128 AVX shift stays conserving. For the same reason every neighbour's
+    // `moved` flag is in the block itself: the free mask shifted by one lane.
+    auto horizBlock = [&](int y, int x, int dx, const Cls& grp, M laneMask) {
         uint8_t* gs = &grid[(size_t)y * SW + x];
         uint8_t* gn = &grid[(size_t)y * SW + (x + dx)];
-        uint8_t* ms = &moved[(size_t)y * SW + x];
-        uint8_t* mn = &moved[(size_t)y * SW + (x + dx)];
-        V cur = Ops::loadu(gs), nbr = Ops::loadu(gn), mc = Ops::loadu(ms), mn_ = Ops::loadu(mn);
-        V m = Ops::And(mask(cur, nbr, mc, mn_, grp), laneMask);
+        uint8_t* ms = movedRow(y) + x;
+        V bs = rowBit(y), flags = Ops::loadu(ms);
+        V cur = Ops::loadu(gs), nbr = Ops::loadu(gn);
+        M free = Ops::testz(flags, bs);
+        free = Ops::And(free, (dx < 0) ? Ops::shl1(free) : Ops::shr1(free));
+        M m = Ops::And(mask(cur, nbr, free, grp), laneMask);
         V shCur = (dx < 0) ? Ops::shr1(cur) : Ops::shl1(cur);
-        V shM   = (dx < 0) ? Ops::shr1(m)   : Ops::shl1(m);
+        M shM   = (dx < 0) ? Ops::shr1(m)   : Ops::shl1(m);
         V out = Ops::blend(cur, nbr, m);
         out = Ops::blend(out, shCur, shM);
         Ops::storeu(gs, out);
-        Ops::storeu(ms, Ops::Or(Ops::Or(mc, m), shM));
+        Ops::storeu(ms, Ops::Or(flags, Ops::select(Ops::Or(m, shM), bs)));
     };
 
-    const V ALL = Ops::ones(), EVEN = Ops::even(), ODD = Ops::odd();
-    // vertical pass: rows of one parity, full width
-    auto vert = [&](int dy, int parity, int grp) {
-        for (int y = Y0 + parity; y < Y1; y += 2)
-            for (int x = X0; x < X1; x += W) swapBlock(y, x, 0, dy, grp, ALL);
+    const M ALL = Ops::ones(), EVEN = Ops::even(), ODD = Ops::odd();
+    // vertical pass: source rows of one parity in [ya, yb), full width
+    auto vert = [&](int dy, int parity, int grp, int ya, int yb) {
+        for (int y = ya + ((Y0 + parity - ya) & 1); y < yb; y += 2) swapRow(y, 0, dy, grp, ALL);
     };
-    // diagonal pass: all rows, one column parity
-    auto diag = [&](int dx, int dy, bool evenCols, int grp) {
-        V lm = evenCols ? EVEN : ODD;
-        for (int y = Y0; y < Y1; ++y)
-            for (int x = X0; x < X1; x += W) swapBlock(y, x, dx, dy, grp, lm);
+    // diagonal pass: every source row in [ya, yb), one column parity
+    auto diag = [&](int dx, int dy, bool evenCols, int grp, int ya, int yb) {
+        M lm = evenCols ? EVEN : ODD;
+        for (int y = ya; y < yb; ++y) swapRow(y, dx, dy, grp, lm);
     };
-    // horizontal pass: all rows, one column parity
-    auto horiz = [&](int dx, bool evenCols, int grp) {
-        V lm = evenCols ? EVEN : ODD;
+    // horizontal pass: every source row in [ya, yb), one column parity
+    auto horiz = [&](int dx, bool evenCols, int grp, int ya, int yb) {
+        M lm = evenCols ? EVEN : ODD;
         if (dx < 0 && evenCols)  lm = Ops::And(lm, Ops::notStart());
         if (dx > 0 && !evenCols) lm = Ops::And(lm, Ops::notEnd());
-        for (int y = Y0; y < Y1; ++y)
-            for (int x = X0; x < X1; x += W) horizBlock(y, x, dx, grp, lm);
+        const Cls& c = cls[grp];
+        for (int y = ya; y < yb; ++y) {
+            const int n = liveBlocks(y, 0, 0, grp);
+            for (int i = 0; i < n; ++i) horizBlock(y, liveX[i], dx, c, lm);
+        }
     };
+    auto runPass = [&](const SubPass& p, int ya, int yb) {
+        if (p.type == 0)      vert(p.dy, p.parity, p.grp, ya, yb);
+        else if (p.type == 1) diag(p.dx, p.dy, p.parity == 0, p.grp, ya, yb);
+        else                  horiz(p.dx, p.parity == 0, p.grp, ya, yb);
+    };
+
+    if (task) {                                                     // one pass of one chunk
+        if (task->pass >= 0) { runPass(kSubPasses[task->pass], Y0, Y1); return skipped; }
+        for (int r = Y0 >> 3; r < (Y1 + 7) >> 3; ++r)
+            std::memset(moved + (size_t)r * SW + task->clearX0, 0, (size_t)(task->clearX1 - task->clearX0));
+        buildSpans(Y0 - 1, Y1 + 1);
+        return 0;
+    }
 
-    std::memset(moved + (size_t)Y0 * SW, 0, (size_t)(Y1 - Y0) * SW);
+    if (band) {                                                     // one worker's rows, pass-major
+        // Bands only meet at their edges. A vertical or diagonal sub-pass's edge source
+        // row (the last for dy > 0, the first for dy < 0) writes the neighbouring band's
+        // first/last row -- and whole W-byte blocks of it, the lanes that do not move
+        // included -- so it runs after a barrier, once that band's own rows are done.
+        // Cells never pair across two moves of a sub-pass, so this is just another
+        // order of the same disjoint swaps: the result is identical to one worker.
+        const int ya = band->ya, yb = band->yb;
+        auto sync = [&] { band->sync(band->ctx); };
+        if (ya < yb) {
+            std::memset(movedRow(ya), 0, (size_t)((yb + 7) / 8 - ya / 8) * SW);
+            buildSpans(ya - 1, yb + 1);                             // before any neighbour moves
+        }
+        sync();
+        for (const SubPass& p : kSubPasses) {
+            if (p.dy == 0) {
+                if (ya < yb) runPass(p, ya, yb);
+            } else {
+                const int edge = (p.dy > 0) ? yb - 1 : ya;
+                if (ya < yb) runPass(p, (p.dy > 0) ? ya : ya + 1, (p.dy > 0) ? yb - 1 : yb);
+                sync();
+                if (ya < yb) runPass(p, edge, edge + 1);
+            }
+            sync();
+        }
+        return skipped;
+    }
 
-    vert(1, 0, SG_DOWN); vert(1, 1, SG_DOWN);                       // sand/water fall
-    diag(-1, 1, true, SG_DOWN); diag(-1, 1, false, SG_DOWN);        // ... down-left
-    diag( 1, 1, true, SG_DOWN); diag( 1, 1, false, SG_DOWN);        // ... down-right
-    vert(-1, 0, SG_GAS); vert(-1, 1, SG_GAS);                       // gas rises
-    diag(-1, -1, true, SG_GAS); diag(-1, -1, false, SG_GAS);        // ... up-left
-    diag( 1, -1, true, SG_GAS); diag( 1, -1, false, SG_GAS);        // ... up-right
-    horiz(-1, true, SG_HORIZ); horiz(-1, false, SG_HORIZ);          // water/gas spread left
-    horiz( 1, true, SG_HORIZ); horiz( 1, false, SG_HORIZ);          // ... and right
+    if (bandRows <= 0) {                                            // pass-major: 16 full sweeps
+        std::memset(movedRow(Y0), 0, (size_t)((Y1 + 7) / 8 - Y0 / 8) * SW);
+        buildSpans(Y0 - 1, Y1 + 1);
+        for (const SubPass& p : kSubPasses) runPass(p, Y0, Y1);
+        return skipped;
+    }
+
+    // Strip-mined: advance every sub-pass through the grid one band at a time, so the
+    // band (plus a small halo) stays cache-resident across all 16 sweeps. Sub-pass p
+    // lags p-1 by SUBPASS_LAG source rows: a source row touches only its own row and
+    // the one above/below, so once p-1 has finished every source row within 2 of it,
+    // no later p-1 work can touch the cells p reads or writes there. That makes the
+    // band order a valid reordering of the pass-major one -- the result is identical.
+    int done[SUBPASSES], zeroed = Y0 >> 3;                          // packed rows cleared so far
+    int summed = Y0 - 1;                                            // rows with span summaries so far
+    for (int& d : done) d = Y0;
+    for (int top = Y0 + bandRows; done[SUBPASSES - 1] < Y1; top += bandRows)
+        for (int p = 0; p < SUBPASSES; ++p) {
+            int to = std::min(Y1, std::max(Y0, top - SUBPASS_LAG * p));
+            int z1 = (std::min(Y1, to + 1) + 7) >> 3;               // clear `moved` / summarise rows
+            if (p == 0 && zeroed < z1) {                            // just ahead of the first sweep
+                std::memset(moved + (size_t)zeroed * SW, 0, (size_t)(z1 - zeroed) * SW);
+                zeroed = z1;
+            }
+            if (p == 0 && summed < std::min(Y1, to) + 1) {
+                buildSpans(summed, std::min(Y1, to) + 1);
+                summed = std::min(Y1, to) + 1;
+            }
+            if (to > done[p]) { runPass(kSubPasses[p], done[p], to); done[p] = to; }
+        }
+    return skipped;
+}
+
+// simdStep() specialised for the table banks `mats` need (moveBanks()): a window
+// without the high ids classifies each block in fewer shuffles.
+template <class Ops, int Banks = 1>
+inline uint64_t simdStepBanks(int banks, uint8_t* grid, uint8_t* moved, int SW,
+                              int X0, int X1, int Y0, int Y1, uint32_t frame, int bandRows,
+                              const StepBand* band, const StepTask* task) {
+    if constexpr (Banks < LUT_GROUPS)
+        if (banks > Banks)
+            return simdStepBanks<Ops, Banks + 1>(banks, grid, moved, SW, X0, X1, Y0, Y1, frame, bandRows, band, task);
+    return simdStep<Ops, Banks>(grid, moved, SW, X0, X1, Y0, Y1, frame, bandRows, band, task);
+}
+template <class Ops>
+inline uint64_t simdStepFor(const uint64_t* mats, uint8_t* grid, uint8_t* moved, int SW,
+                            int X0, int X1, int Y0, int Y1, uint32_t frame, int bandRows = 0,
+                            const StepBand* band = nullptr, const StepTask* task = nullptr) {
+    return simdStepBanks<Ops>(moveBanks(mats), grid, moved, SW, X0, X1, Y0, Y1, frame, bandRows, band, task);
 }
@@ -0,0 +1,354 @@
+// SIMD mark/apply passes for the always-on neighbour-predicate reactions of materials.h
+// and the two automata conwayLife and wireWorld. The reactions are not written out here:
+// TableRule<R> evaluates row R of kReactionRules (reaction_rules.h) W cells at a time
+// with the movement step's Ops policies, and writes the same marks and cells as the
+// scalar rule of the same name, so it is bit-identical to materials.h (which stays the
+// reference the GPU mirrors).
+//
+// The frame hashes keep only their low 8 bits, so they are evaluated in byte lanes:
+// (x*ax + y*ay + frame*af) mod 256 is the block's scalar part plus a per-lane ramp
+// l*ax, added with wrapping byte adds and compared unsigned against the threshold.
+//
+// What the rows ask of a cell's 4 neighbours is always one of a few materials -- fire,
+// lava, water, a plant, acid, ice -- so a neighbour is looked up once in a class table
+// (kNearClass, one pshufb) and the four ORed: one byte per cell with a bit per material,
+// which each clause tests against the bits of its `near` list instead of comparing
+// every neighbour against every material it wants.
+#pragma once
+#include "simd_core.h"
+#include "reaction_rules.h"
+
+static_assert(kRuleCount == SR_MUD_CYCLE + 1, "kReactionRules has one row per SimdReaction up to SR_MUD_CYCLE");
+
+// One-lane policy for the columns past the last full block. Templated on the wide
+// policy only so that each ISA's object keeps its own copy of the scalar tail.
+template <class Wide>
+struct TailOps {
+    using V = uint8_t;
+    using M = bool;
+    static constexpr int W = 1;
+    static V loadu(const uint8_t* p) { return *p; }
+    static void storeu(uint8_t* p, V v) { *p = v; }
+    static V set1(int b) { return (uint8_t)b; }
+    static M eq(V a, V b) { return a == b; }
+    static M And(M a, M b) { return a && b; }
+    static M Or(M a, M b) { return a || b; }
+    static V blend(V a, V b, M m) { return m ? b : a; }
+    static M testnz(V a, V b) { return (a & b) != 0; }
+    static V select(M m, V v) { return m ? v : 0; }
+    static V add(V a, V b) { return (uint8_t)(a + b); }
+    static M leu(V a, V b) { return a <= b; }
+};
+
+// A frame hash `(x*ax + y*ay + frame*af) & 0xFF < below`, with its lane ramp.
+struct ByteHash { uint8_t ax, ay, af, below; uint8_t ramp[64]; };
+constexpr ByteHash byteHash(uint32_t ax, uint32_t ay, uint32_t af, uint32_t below) {
+    ByteHash h{(uint8_t)ax, (uint8_t)ay, (uint8_t)af, (uint8_t)below, {}};
+    for (uint32_t l = 0; l < 64; ++l) h.ramp[l] = (uint8_t)(l * ax);
+    return h;
+}
+// Every clause's hash, by row and clause.
+struct RuleHashes { ByteHash h[kRuleCount][4]; };
+constexpr RuleHashes ruleHashes() {
+    RuleHashes t{};
+    for (int r = 0; r < kRuleCount; ++r)
+        for (int k = 0; k < clauseCount(kReactionRules[r]); ++k) {
+            const RuleHash& h = kReactionRules[r].clause[k].hash;
+            t.h[r][k] = byteHash(h.ax, h.ay, h.af, h.below);
+        }
+    return t;
+}
+static constexpr RuleHashes kRuleHashes = ruleHashes();
+
+// Neighbour classes: each material some `near`/`near2` list names gets a bit, and bit k
+// of a cell's class byte is set when one of its 4 neighbours is that material. Every
+// one is an id below 16, so one shuffle classifies a block (ids past 15 steer to a lane
+// with bit 7 set, which the shuffle zeroes).
+struct NearTable { uint8_t cls[16]; int count; };
+constexpr NearTable nearTable() {
+    NearTable t{};
+    for (const ReactionRule& r : kReactionRules)
+        for (int k = 0; k < clauseCount(r); ++k)
+            for (const MatList* l : {&r.clause[k].near, &r.clause[k].near2})
+                for (int j = 0; j < l->n; ++j) {
+                    if (l->id[j] >= 16) return NearTable{{}, -1};
+                    if (!t.cls[l->id[j]]) t.cls[l->id[j]] = (uint8_t)(1u << t.count++);
+                }
+    return t;
+}
+static constexpr NearTable kNearClass = nearTable();
+static_assert(kNearClass.count >= 0, "a neighbour material past id 15 needs a second shuffle bank");
+static_assert(kNearClass.count <= 8, "more than 8 neighbour materials need a wider class byte");
+// The class bits of a list: any of its materials among the neighbours.
+constexpr uint8_t nearBits(const MatList& l) {
+    uint8_t b = 0;
+    for (int j = 0; j < l.n; ++j) b |= kNearClass.cls[l.id[j]];
+    return b;
+}
+
+template <class Ops>
+typename Ops::V nearClass(typename Ops::V v) {
+    if constexpr (Ops::W == 1) return v < 16 ? kNearClass.cls[v] : 0;
+    else return Ops::shuffle(Ops::bcast16(kNearClass.cls), Ops::addsu8(v, Ops::set1(0x70)));
+}
+// The class bytes of the W cells at i, from their neighbours in the grid.
+template <class Ops>
+typename Ops::V nearOf(const uint8_t* g, size_t i, int SW) {
+    if constexpr (Ops::W == 1)   // TailOps' Or is on masks
+        return nearClass<Ops>(g[i - 1]) | nearClass<Ops>(g[i + 1]) | nearClass<Ops>(g[i - SW]) | nearClass<Ops>(g[i + SW]);
+    else
+        return Ops::Or(Ops::Or(nearClass<Ops>(Ops::loadu(g + i - 1)), nearClass<Ops>(Ops::loadu(g + i + 1))),
+                       Ops::Or(nearClass<Ops>(Ops::loadu(g + i - SW)), nearClass<Ops>(Ops::loadu(g + i + SW))));
+}
+// Lanes of c that hold one of the list's materials.
+template <class Ops>
+typename Ops::M anyOf(typename Ops::V c, const MatList& l) {
+    typename Ops::M m = Ops::eq(c, Ops::set1(l.id[0]));
+    for (int j = 1; j < l.n; ++j) m = Ops::Or(m, Ops::eq(c, Ops::set1(l.id[j])));
+    return m;
+}
+
+// W cells of one row and their neighbour classes, the operand of every mark below.
+template <class Ops>
+struct Cross {
+    using V = typename Ops::V;
+    using M = typename Ops::M;
+    V c, cls;
+    int x, y;
+    uint32_t frame;
+    Cross(const uint8_t* g, size_t i, int SW, int x, int y, uint32_t frame)
+        : c(Ops::loadu(g + i)), cls(nearOf<Ops>(g, i, SW)), x(x), y(y), frame(frame) {}
+    M nb(uint8_t bits) const { return Ops::testnz(cls, Ops::set1(bits)); }   // a neighbour of these classes
+    M hash(const ByteHash& h) const {
+        const uint8_t base = (uint8_t)((uint32_t)x * h.ax + (uint32_t)y * h.ay + frame * h.af);
+        return Ops::leu(Ops::add(Ops::set1(base), Ops::loadu(h.ramp)), Ops::set1(h.below - 1));
+    }
+};
+
+// Row R of kReactionRules: mark(n) is the scratch byte of the scalar mark pass, apply(c,
+// s) the cell its apply pass leaves given the cell c and its mark s. The clauses are
+// unrolled at compile time, so a row costs what its hand-written rule did.
+template <int R>
+struct TableRule {
+    static constexpr const ReactionRule& rule = kReactionRules[R];
+    static constexpr int N = clauseCount(rule);
+
+    // Clause K holds for the W cells of n: `given` is all of it but the `near` test.
+    template <class Ops, int K>
+    static typename Ops::M given(const Cross<Ops>& n) {
+        constexpr const RuleClause& c = rule.clause[K];
+        auto m = anyOf<Ops>(n.c, c.self);
+        if constexpr (c.near2.n > 0) m = Ops::And(m, n.nb(nearBits(c.near2)));
+        if constexpr (c.hash.below > 0) m = Ops::And(m, n.hash(kRuleHashes.h[R][K]));
+        return m;
+    }
+    template <class Ops, int K>
+    static typename Ops::M holds(const Cross<Ops>& n) {
+        return Ops::And(given<Ops, K>(n), n.nb(nearBits(rule.clause[K].near)));
+    }
+    // Any clause holds. Clauses testing the same neighbours share one test, as the
+    // hand-written rules did (ignite's `hot && (fuel || wood && hash)`).
+    static constexpr bool sameNear(int j, int k) {
+        return nearBits(rule.clause[j].near) == nearBits(rule.clause[k].near);
+    }
+    static constexpr bool leadsNear(int k) {
+        for (int j = 0; j < k; ++j)
+            if (sameNear(j, k)) return false;
+        return true;
+    }
+    template <class Ops, int K, int J = K + 1>
+    static typename Ops::M group(const Cross<Ops>& n, typename Ops::M m) {
+        if constexpr (J == N) return Ops::And(m, n.nb(nearBits(rule.clause[K].near)));
+        else if constexpr (sameNear(J, K)) return group<Ops, K, J + 1>(n, Ops::Or(m, given<Ops, J>(n)));
+        else return group<Ops, K, J + 1>(n, m);
+    }
+    template <class Ops, int K = 1>
+    static typename Ops::M any(const Cross<Ops>& n, typename Ops::M m) {
+        if constexpr (K == N) return m;
+        else if constexpr (leadsNear(K)) return any<Ops, K + 1>(n, Ops::Or(m, group<Ops, K>(n, given<Ops, K>(n))));
+        else return any<Ops, K + 1>(n, m);
+    }
+    // Clauses K.. over the marks of the ones before (no two hold for the same cell).
+    template <class Ops, int K = 1>
+    static typename Ops::V marks(const Cross<Ops>& n, typename Ops::V v) {
+        if constexpr (K == N) return v;
+        else return marks<Ops, K + 1>(n, Ops::blend(v, Ops::set1(rule.clause[K].mark), holds<Ops, K>(n)));
+    }
+    template <class Ops> static typename Ops::V mark(const Cross<Ops>& n) {
+        if constexpr (marksOne(rule)) return Ops::select(any<Ops>(n, group<Ops, 0>(n, given<Ops, 0>(n))), Ops::set1(1));
+        else return marks<Ops>(n, Ops::select(holds<Ops, 0>(n), Ops::set1(rule.clause[0].mark)));
+    }
+
+    // What a cell c marked Mk becomes: the `into` of the last clause with that mark,
+    // unless c is the `self` of an earlier one (clauses K-1..0 over v).
+    template <class Ops, int Mk, int K>
+    static typename Ops::V product(typename Ops::V c, typename Ops::V v) {
+        if constexpr (K == 0) return v;
+        else {
+            constexpr const RuleClause& cl = rule.clause[K - 1];
+            if constexpr (cl.mark == Mk && cl.into != rule.clause[lastWithMark(rule, Mk)].into)
+                v = Ops::blend(v, Ops::set1(cl.into), anyOf<Ops>(c, cl.self));
+            return product<Ops, Mk, K - 1>(c, v);
+        }
+    }
+    template <class Ops, int Mk>
+    static typename Ops::V product(typename Ops::V c) {
+        constexpr int last = lastWithMark(rule, Mk);
+        return product<Ops, Mk, last>(c, Ops::set1(rule.clause[last].into));
+    }
+    // Each distinct mark, at its first clause.
+    template <class Ops, int K = 0>
+    static typename Ops::V applyMarks(typename Ops::V c, typename Ops::V s, typename Ops::V v) {
+        if constexpr (K == N) return v;
+        else {
+            constexpr int Mk = rule.clause[K].mark;
+            if constexpr (firstWithMark(rule, Mk) == K)
+                v = Ops::blend(v, product<Ops, Mk>(c), Ops::eq(s, Ops::set1(Mk)));
+            return applyMarks<Ops, K + 1>(c, s, v);
+        }
+    }
+    template <class Ops> static typename Ops::V apply(typename Ops::V c, typename Ops::V s) {
+        if constexpr (marksOne(rule)) return Ops::blend(c, product<Ops, 1>(c), Ops::testnz(s, s));
+        else return applyMarks<Ops>(c, s, c);
+    }
+};
+
+// --- bit-sliced automata -----------------------------------------------------------
+// Life and Wireworld decide a cell by how many of its 8 neighbours hold one material.
+// They run on bitplanes, 64 cells of a row at a time: a uint64_t holds "cell == m" for
+// the 64 cells (built W lanes at a time with eq/bits), the neighbour planes are that
+// plane of the rows above, at and below shifted a column either way (with the cells
+// just past the block shifted in), and a carry-save adder network sums the eight into
+// bit-sliced counts with word-wide logic. The fates are scattered back into scratch
+// bytes (lanes/select) exactly as the scalar mark writes them.
+
+// Bit k: p[k] == m, for k < n <= 64.
+template <class Ops>
+uint64_t plane(const uint8_t* p, int m, int n) {
+    uint64_t b = 0;
+    if (n == 64)
+        for (int k = 0; k < 64; k += Ops::W) b |= Ops::bits(Ops::eq(Ops::loadu(p + k), Ops::set1(m))) << k;
+    else
+        for (int k = 0; k < n; ++k) b |= (uint64_t)(p[k] == m) << k;
+    return b;
+}
+// The 8-neighbour counts of n cells at p, as "exactly one", "exactly two" and "exactly
+// three" of `m`.
+struct Counts { uint64_t one, two, three; };
+template <class Ops>
+Counts count8(const uint8_t* p, int SW, int m, int n) {
+    uint64_t nb[9];                                  // by row, then left / right / straight
+    for (int r = 0; r < 3; ++r) {
+        const uint8_t* q = p + (r - 1) * SW;
+        const uint64_t c = plane<Ops>(q, m, n);
+        nb[3 * r] = (c << 1) | (uint64_t)(q[-1] == m);                 // the cell to the left
+        nb[3 * r + 1] = (c >> 1) | ((uint64_t)(q[n] == m) << (n - 1));   // to the right
+        nb[3 * r + 2] = c;                                              // (the cell itself at r == 1)
+    }
+    auto full = [](uint64_t a, uint64_t b, uint64_t c, uint64_t& carry) {
+        carry = (a & b) | (c & (a ^ b));
+        return a ^ b ^ c;
+    };
+    uint64_t cu, cd, c1;
+    const uint64_t su = full(nb[0], nb[1], nb[2], cu), sd = full(nb[6], nb[7], nb[8], cd);
+    const uint64_t sm = nb[3] ^ nb[4], cm = nb[3] & nb[4];
+    const uint64_t s1 = full(su, sd, sm, c1);       // the count is s1 + 2 * (cu + cd + cm + c1)
+    const uint64_t k0 = ~(cu | cd | cm | c1);
+    const uint64_t k1 = (cu ^ cd ^ cm ^ c1) & ~((cu & cd) | (cm & c1));
+    return {k0 & s1, k1 & ~s1, k1 & s1};
+}
+// Scatter three cell sets to scratch bytes va/vb/vc (the rest 0), n <= 64 cells.
+template <class Ops>
+void scatter(uint8_t* s, int n, uint64_t a, int va, uint64_t b, int vb, uint64_t c, int vc) {
+    if (n == 64)
+        for (int k = 0; k < 64; k += Ops::W)
+            Ops::storeu(s + k, Ops::Or(Ops::Or(Ops::select(Ops::lanes(a >> k), Ops::set1(va)),
+                                               Ops::select(Ops::lanes(b >> k), Ops::set1(vb))),
+                                       Ops::select(Ops::lanes(c >> k), Ops::set1(vc))));
+    else
+        for (int k = 0; k < n; ++k)
+            s[k] = (a >> k & 1) ? va : (b >> k & 1) ? vb : (c >> k & 1) ? vc : 0;
+}
+
+struct LifeRule {
+    template <class Ops> static void sliced(const uint8_t* g, uint8_t* s, int SW, int n) {
+        const Counts k = count8<Ops>(g, SW, LIFE, n);
+        const uint64_t live = plane<Ops>(g, LIFE, n), empty = plane<Ops>(g, EMPTY, n);
+        const uint64_t lives = (live & (k.two | k.three)) | (empty & k.three);
+        scatter<Ops>(s, n, lives, 1, live & ~lives, 2, 0, 0);
+    }
+    template <class Ops> static typename Ops::V apply(typename Ops::V c, typename Ops::V s) {
+        auto v = Ops::blend(c, Ops::set1(LIFE), Ops::eq(s, Ops::set1(1)));
+        return Ops::blend(v, Ops::set1(EMPTY), Ops::eq(s, Ops::set1(2)));
+    }
+};
+struct WireworldRule {
+    template <class Ops> static void sliced(const uint8_t* g, uint8_t* s, int SW, int n) {
+        const Counts k = count8<Ops>(g, SW, EHEAD, n);
+        const uint64_t wire = plane<Ops>(g, WIRE, n), fires = wire & (k.one | k.two);
+        scatter<Ops>(s, n, plane<Ops>(g, EHEAD, n), ETAIL, plane<Ops>(g, ETAIL, n) | (wire & ~fires), WIRE, fires, EHEAD);
+    }
+    template <class Ops> static typename Ops::V apply(typename Ops::V c, typename Ops::V s) {
+        return Ops::blend(c, s, Ops::testnz(s, s));
+    }
+};
+
+// The rule's apply over [X0, X1) x [Y0, Y1): whole W-cell blocks, then the tail.
+template <class Ops, class Rule>
+void applyRule(uint8_t* grid, const uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1) {
+    using T = TailOps<Ops>;
+    constexpr int W = Ops::W;
+    for (int y = Y0; y < Y1; ++y) {
+        const size_t row = (size_t)y * SW;
+        int x = X0;
+        for (; x + W <= X1; x += W)
+            Ops::storeu(grid + row + x, Rule::template apply<Ops>(Ops::loadu(grid + row + x), Ops::loadu(scratch + row + x)));
+        for (; x < X1; ++x)
+            T::storeu(grid + row + x, Rule::template apply<T>(T::loadu(grid + row + x), T::loadu(scratch + row + x)));
+    }
+}
+
+// The rule's passes over [X0, X1) x [Y0, Y1): whole W-cell blocks, then the tail.
+template <class Ops, class Rule>
+void reactRule(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes) {
+    using T = TailOps<Ops>;
+    constexpr int W = Ops::W;
+    if (passes & MARK_PASS)
+        for (int y = Y0; y < Y1; ++y) {
+            const size_t row = (size_t)y * SW;
+            int x = X0;
+            for (; x + W <= X1; x += W)
+                Ops::storeu(scratch + row + x, Rule::template mark<Ops>(Cross<Ops>(grid, row + x, SW, x, y, frame)));
+            for (; x < X1; ++x)
+                T::storeu(scratch + row + x, Rule::template mark<T>(Cross<T>(grid, row + x, SW, x, y, frame)));
+        }
+    if (passes & APPLY_PASS) applyRule<Ops, Rule>(grid, scratch, SW, X0, X1, Y0, Y1);
+}
+
+// The same for an automaton: its mark 64 cells at a time, on bitplanes.
+template <class Ops, class Rule>
+void sliceRule(uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, int passes) {
+    if (passes & MARK_PASS)
+        for (int y = Y0; y < Y1; ++y) {
+            const size_t row = (size_t)y * SW;
+            for (int x = X0; x < X1; x += 64)
+                Rule::template sliced<Ops>(grid + row + x, scratch + row + x, SW, std::min(64, X1 - x));
+        }
+    if (passes & APPLY_PASS) applyRule<Ops, Rule>(grid, scratch, SW, X0, X1, Y0, Y1);
+}
+
+template <class Ops>
+void simdReact(int rule, uint8_t* grid, uint8_t* scratch, int SW, int X0, int X1, int Y0, int Y1, uint32_t frame, int passes) {
+    switch (rule) {
+        case SR_IGNITE:        reactRule<Ops, TableRule<SR_IGNITE>>(grid, scratch, SW, X0, X1, Y0, Y1, frame, passes); break;
+        case SR_QUENCH:        reactRule<Ops, TableRule<SR_QUENCH>>(grid, scratch, SW, X0, X1, Y0, Y1, frame, passes); break;
+        case SR_GROW_PLANT:    reactRule<Ops, TableRule<SR_GROW_PLANT>>(grid, scratch, SW, X0, X1, Y0, Y1, frame, passes); break;
+        case SR_DISSOLVE_ACID: reactRule<Ops, TableRule<SR_DISSOLVE_ACID>>(grid, scratch, SW, X0, X1, Y0, Y1, frame, passes); break;
+        case SR_MAKE_GLASS:    reactRule<Ops, TableRule<SR_MAKE_GLASS>>(grid, scratch, SW, X0, X1, Y0, Y1, frame, passes); break;
+        case SR_MELT_ICE:      reactRule<Ops, TableRule<SR_MELT_ICE>>(grid, scratch, SW, X0, X1, Y0, Y1, frame, passes); break;
+        case SR_FREEZE_WATER:  reactRule<Ops, TableRule<SR_FREEZE_WATER>>(grid, scratch, SW, X0, X1, Y0, Y1, frame, passes); break;
+        case SR_MUD_CYCLE:     reactRule<Ops, TableRule<SR_MUD_CYCLE>>(grid, scratch, SW, X0, X1, Y0, Y1, frame, passes); break;
+        case SR_LIFE:          sliceRule<Ops, LifeRule>(grid, scratch, SW, X0, X1, Y0, Y1, passes); break;
+        case SR_WIREWORLD:     sliceRule<Ops, WireworldRule>(grid, scratch, SW, X0, X1, Y0, Y1, passes); break;
+    }
+}
@@ -0,0 +1,125 @@
+// A fixed team of worker threads for the banded (multi-threaded) step. The team is
+// the calling thread plus n-1 persistent workers, each pinned to its own core: run()
+// hands every member the same job with its index and returns once all are done, and
+// sync() inside a job is a barrier across the whole team. One run() per stepped
+// rectangle per frame; the passes inside it are separated by sync() alone.
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>   // _mm_pause
+#endif
+
+class ThreadPool {
+public:
+    explicit ThreadPool(int n) : n(n < 1 ? 1 : n) {
+        if (this->n == 1) return;
+        pin(pthreadSelf(), 0);
+        for (int t = 1; t < this->n; ++t) {
+            workers.emplace_back([this, t] { work(t); });
+            pin(workers.back().native_handle(), t);
+        }
+    }
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lk(m);
+            quit = true;
+            ++jobGen;
+        }
+        cv.notify_all();
+        for (std::thread& w : workers) w.join();
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return n; }
+
+    // Run job(t) for every t in [0, size()), t = 0 on the calling thread.
+    void run(const std::function<void(int)>& fn) {
+        if (n == 1) { fn(0); return; }
+        {
+            std::lock_guard<std::mutex> lk(m);
+            job = &fn;
+            pending = n - 1;
+            ++jobGen;
+        }
+        cv.notify_all();
+        fn(0);
+        std::unique_lock<std::mutex> lk(m);
+        doneCv.wait(lk, [this] { return pending == 0; });
+    }
+
+    // Barrier: returns once every member of the team has reached it. Spins briefly,
+    // then yields, so an oversubscribed team (more threads than cores) still moves.
+    void sync() {
+        if (n == 1) return;
+        const unsigned gen = barGen.load(std::memory_order_acquire);
+        if (barCount.fetch_add(1, std::memory_order_acq_rel) + 1 == n) {
+            barCount.store(0, std::memory_order_relaxed);
+            barGen.store(gen + 1, std::memory_order_release);
+            return;
+        }
+        for (int spin = 0; barGen.load(std::memory_order_acquire) == gen; ++spin) {
+            if (spin < 256) pause();
+            else std::this_thread::yield();
+        }
+    }
+    static void syncThunk(void* pool) { static_cast<ThreadPool*>(pool)->sync(); }
+
+private:
+    void work(int t) {
+        unsigned seen = 0;
+        for (;;) {
+            const std::function<void(int)>* fn;
+            {
+                std::unique_lock<std::mutex> lk(m);
+                cv.wait(lk, [&] { return jobGen != seen; });
+                seen = jobGen;
+                if (quit) return;
+                fn = job;
+            }
+            (*fn)(t);
+            std::lock_guard<std::mutex> lk(m);
+            if (--pending == 0) doneCv.notify_one();
+        }
+    }
+    static void pause() {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif
+    }
+#if defined(__linux__)
+    static pthread_t pthreadSelf() { return pthread_self(); }
+    // Member t on core t (mod the core count), so a band's rows stay in one core's caches.
+    static void pin(pthread_t th, int t) {
+        const unsigned cores = std::thread::hardware_concurrency();
+        if (cores == 0) return;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(t % cores, &set);
+        pthread_setaffinity_np(th, sizeof(set), &set);
+    }
+#else
+    static int pthreadSelf() { return 0; }
+    template <class H> static void pin(H, int) {}
+#endif
+
+    const int n;
+    std::vector<std::thread> workers;
+    std::mutex m;
+    std::condition_variable cv, doneCv;
+    const std::function<void(int)>* job = nullptr;
+    unsigned jobGen = 0;
+    int pending = 0;
+    bool quit = false;
+    std::atomic<int> barCount{0};
+    std::atomic<unsigned> barGen{0};
+};
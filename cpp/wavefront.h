@@ -0,0 +1,112 @@
+// Dependency-driven frame schedule over a block of chunks, without frame-wide barriers.
+// A frame is a list of passes (movement sub-passes, reaction marks and applies); the
+// task (chunk, pass) becomes ready as soon as its chunk and its 8 neighbours have
+// finished the previous pass, so chunks run ahead of each other in a wavefront as far
+// as their neighbourhood allows. A pass marked `exclusive` (one that writes a cell past
+// its chunk) also orders neighbours within the pass by a 2x2 colouring: the four
+// colours run one after another locally, and no two adjacent chunks run it at once.
+//
+// Each team member owns a deque of ready tasks: it pops its own newest task (most
+// often the next pass of the chunk it just finished, still in its cache) and, when
+// empty, steals the oldest task of another member.
+#pragma once
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class Wavefront {
+public:
+    // Run body(member, cx, cy, pass) for every chunk of a cw x ch block and every pass
+    // in [0, exclusive.size()), each once all of its predecessors are done.
+    template <class Body>
+    void run(ThreadPool& pool, int cw, int ch, const std::vector<uint8_t>& exclusive, Body&& body) {
+        const int n = cw * ch, passes = (int)exclusive.size(), total = n * passes;
+        if (total == 0) return;
+        this->cw = cw; this->ch = ch; this->n = n; this->passes = passes; this->excl = &exclusive;
+        if ((int)deps.size() < total) deps = std::vector<std::atomic<int>>((size_t)total);
+        for (int p = 0; p < passes; ++p)
+            for (int c = 0; c < n; ++c) {
+                int d = 0;
+                forNeighbours(c, true, [&](int nb) {
+                    if (p > 0) ++d;
+                    if (exclusive[p] && nb != c && colour(nb) < colour(c)) ++d;
+                });
+                deps[(size_t)p * n + c].store(d, std::memory_order_relaxed);
+            }
+        const int members = pool.size();
+        if ((int)queues.size() < members) {
+            queues.clear();
+            for (int t = 0; t < members; ++t) queues.emplace_back(new Queue);
+        }
+        for (int c = 0, t = 0; c < n; ++c)               // pass 0's ready tasks, dealt round-robin
+            if (deps[c].load(std::memory_order_relaxed) == 0) { queues[t]->q.push_back(c); t = (t + 1) % members; }
+        left.store(total, std::memory_order_relaxed);
+
+        pool.run([&](int t) {
+            for (int spin = 0; left.load(std::memory_order_acquire) > 0;) {
+                int task;
+                if (!take(t, members, task)) {
+                    if (++spin > 256) std::this_thread::yield();
+                    continue;
+                }
+                spin = 0;
+                const int p = task / n, c = task % n;
+                body(t, c % cw, c / cw, p);
+                finish(t, c, p);
+                left.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        });
+    }
+
+private:
+    struct Queue { std::mutex m; std::deque<int> q; };
+
+    static int colour(int cx, int cy) { return (cx & 1) | ((cy & 1) << 1); }
+    int colour(int c) const { return colour(c % cw, c / cw); }
+    template <class F> void forNeighbours(int c, bool self, F&& f) const {
+        const int cx = c % cw, cy = c / cw;
+        for (int y = std::max(0, cy - 1); y <= std::min(ch - 1, cy + 1); ++y)
+            for (int x = std::max(0, cx - 1); x <= std::min(cw - 1, cx + 1); ++x)
+                if (self || x != cx || y != cy) f(y * cw + x);
+    }
+
+    bool take(int t, int members, int& task) {
+        {
+            Queue& own = *queues[t];
+            std::lock_guard<std::mutex> lk(own.m);
+            if (!own.q.empty()) { task = own.q.back(); own.q.pop_back(); return true; }
+        }
+        for (int i = 1; i < members; ++i) {
+            Queue& v = *queues[(t + i) % members];
+            std::lock_guard<std::mutex> lk(v.m);
+            if (!v.q.empty()) { task = v.q.front(); v.q.pop_front(); return true; }
+        }
+        return false;
+    }
+    void release(int t, int task) {
+        if (deps[task].fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        Queue& own = *queues[t];
+        std::lock_guard<std::mutex> lk(own.m);
+        own.q.push_back(task);
+    }
+    // (c, p) is done: the next pass of c and its neighbours, and -- in an exclusive
+    // pass -- this pass of the neighbours coloured after c, lose a dependency.
+    // c's own next pass is released last, so its member picks it up next.
+    void finish(int t, int c, int p) {
+        if ((*excl)[p])
+            forNeighbours(c, false, [&](int nb) { if (colour(nb) > colour(c)) release(t, p * n + nb); });
+        if (p + 1 == passes) return;
+        forNeighbours(c, false, [&](int nb) { release(t, (p + 1) * n + nb); });
+        release(t, (p + 1) * n + c);
+    }
+
+    int cw = 0, ch = 0, n = 0, passes = 0;
+    const std::vector<uint8_t>* excl = nullptr;
+    std::vector<std::atomic<int>> deps;
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::atomic<int> left{0};
+};
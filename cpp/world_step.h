@@ -1,28 +1,209 @@
-// One materials step over the padded grid interior. Two implementations live in
-// separate TUs compiled with -msse4.1 and -mavx2; the host picks the widest the
-// running CPU supports at startup. Both compute the same result (the rule is
-// width-independent), so the choice is purely performance.
+// One materials step over the padded grid interior. Three implementations live in
+// separate TUs compiled with -msse4.1, -mavx2 and -mavx512bw; the host picks the
+// widest the running CPU supports at startup. All compute the same result (the rule
+// is width-independent), so the choice is purely performance.
 #pragma once
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 
-using StepFn = void (*)(uint8_t* grid, uint8_t* moved, int SW,
-                        int X0, int X1, int Y0, int Y1, uint32_t frame);
+// `moved` is the step's own scratch, zeroed by the step itself: one bit per cell,
+// packed 8 rows deep -- row y's flag for column x is bit y%8 of byte (y/8)*SW + x.
+// That keeps the byte-per-column addressing of the grid (unaligned column offsets stay
+// plain loads) at an eighth of the bytes; a buffer of movedBytes(SW, SH) suffices.
+inline size_t movedBytes(int SW, int SH) { return (size_t)(SH + 7) / 8 * SW; }
 
-extern "C" void worldStepSSE(uint8_t* grid, uint8_t* moved, int SW,
-                             int X0, int X1, int Y0, int Y1, uint32_t frame);
-extern "C" void worldStepAVX(uint8_t* grid, uint8_t* moved, int SW,
-                             int X0, int X1, int Y0, int Y1, uint32_t frame);
+// Any stride and placement work. When SW is a multiple of 64 and grid + X0 and moved +
+// X0 start cache lines (grid_buffer.h lays the host's buffers out so), the vertical
+// sub-passes use aligned loads and stores.
+// Returns the number of W-lane blocks skipped as inert (see SpanSum in simd_core.h).
+// Every step entry point takes the materials the window holds, as the two words of a
+// MatMask (materials.h), or nullptr for any: the classifier then reads only the
+// 16-id table banks those materials need (see simdStepBanks()). Reactions that run in
+// the same frame cannot change what the movement sees, so the set from the start of
+// the frame holds for the whole step.
+using StepFn = uint64_t (*)(uint8_t* grid, uint8_t* moved, int SW,
+                            int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats);
 
-// SANDSIM_SIMD=sse|avx forces a path (for testing); otherwise pick the widest
-// the running CPU supports (AVX2 -> 32 lanes, else SSE -> 16). Both compute the
-// same result, so this is purely a performance / verification knob.
-inline bool wantAVX() {
+extern "C" uint64_t worldStepSSE(uint8_t* grid, uint8_t* moved, int SW,
+                                 int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats);
+extern "C" uint64_t worldStepAVX(uint8_t* grid, uint8_t* moved, int SW,
+                                 int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats);
+extern "C" uint64_t worldStepAVX512(uint8_t* grid, uint8_t* moved, int SW,
+                                    int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats);
+// Same step, with the 16 movement sub-passes fused over cache-sized row bands
+// (see simdStep()); bit-identical to the pass-major entry points above.
+extern "C" uint64_t worldStepFusedSSE(uint8_t* grid, uint8_t* moved, int SW,
+                                      int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats);
+extern "C" uint64_t worldStepFusedAVX(uint8_t* grid, uint8_t* moved, int SW,
+                                      int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats);
+extern "C" uint64_t worldStepFusedAVX512(uint8_t* grid, uint8_t* moved, int SW,
+                                         int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats);
+// Same step on bitplanes (plane_step.h): the rectangle is transposed into 7 planes of
+// id bits, moved with word-wide logic and written back. Bit-identical; a rectangle
+// that is not whole 64-cell spans wide takes the byte step instead.
+extern "C" uint64_t worldStepPlanesSSE(uint8_t* grid, uint8_t* moved, int SW,
+                                       int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats);
+extern "C" uint64_t worldStepPlanesAVX(uint8_t* grid, uint8_t* moved, int SW,
+                                       int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats);
+extern "C" uint64_t worldStepPlanesAVX512(uint8_t* grid, uint8_t* moved, int SW,
+                                          int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats);
+
+// One worker's share of a multi-threaded movement frame: source rows [ya, yb) of
+// every sub-pass of the frame [Y0, Y1), with sync(ctx) a barrier across all of the
+// frame's workers. Bands tile [Y0, Y1) in order, start on a multiple of 8 (`moved`
+// packs 8 rows to a byte) and are at least 16 rows tall; ya == yb is an idle worker,
+// which still takes part in every barrier. See simdStep().
+struct StepBand {
+    int ya, yb;
+    void (*sync)(void* ctx);
+    void* ctx;
+};
+static constexpr int STEP_BAND_MIN_ROWS = 16;
+using BandStepFn = uint64_t (*)(uint8_t* grid, uint8_t* moved, int SW,
+                                int X0, int X1, int Y0, int Y1, uint32_t frame, const StepBand* band, const uint64_t* mats);
+extern "C" uint64_t worldStepBandSSE(uint8_t* grid, uint8_t* moved, int SW,
+                                     int X0, int X1, int Y0, int Y1, uint32_t frame, const StepBand* band, const uint64_t* mats);
+extern "C" uint64_t worldStepBandAVX(uint8_t* grid, uint8_t* moved, int SW,
+                                     int X0, int X1, int Y0, int Y1, uint32_t frame, const StepBand* band, const uint64_t* mats);
+extern "C" uint64_t worldStepBandAVX512(uint8_t* grid, uint8_t* moved, int SW,
+                                        int X0, int X1, int Y0, int Y1, uint32_t frame, const StepBand* band, const uint64_t* mats);
+
+// Span summary: for one row and one SPAN-cell stretch of it, the OR over its cells of
+// each movement group's classifier bytes (mover[] and target[] of MoveLut, see
+// simd_core.h), so one AND proves a block inert.
+static constexpr int SPAN = 64;
+struct SpanSum { uint8_t mover[3], target[3]; };
+// Enough summaries for a frame over [X0, X1) x [Y0, Y1), for any SIMD width.
+inline size_t spanSumCount(int X0, int X1, int Y0, int Y1) {
+    return (size_t)(Y1 - Y0 + 2) * ((X1 - X0 + 2 * SPAN - 2) / SPAN);
+}
+
+// One task of a task-scheduled movement frame over the chunk [X0, X1) x [Y0, Y1).
+// pass < 0 prepares the chunk -- clears its `moved` rows over columns [clearX0,
+// clearX1) and summarises its rows and the one on either side into `spans`, which
+// the chunk's later tasks read -- and pass 0..15 runs that sub-pass over the chunk's
+// source cells. A sub-pass writes one row/column past its chunk (with whole W-byte
+// blocks), so the scheduler never runs two tasks of adjacent chunks at once and
+// runs a chunk's pass only after its 8 neighbours finished the one before. `blocks`
+// is the running worker's own stepBlockBytes(X1 - X0) bytes, 64-byte aligned, where a
+// sub-pass lists the blocks it swaps and their move masks; every task the worker runs
+// reuses it.
+static constexpr int STEP_SUBPASSES = 16;   // kSubPasses in simd_core.h
+struct StepTask {
+    int pass;
+    int clearX0, clearX1;
+    SpanSum* spans;
+    uint8_t* blocks;
+};
+// Enough StepTask::blocks for a chunk `w` cells wide, for any SIMD width.
+inline size_t stepBlockBytes(int w) { return (size_t)(w + 15) / 16 * (64 + sizeof(int)); }
+using TaskStepFn = uint64_t (*)(uint8_t* grid, uint8_t* moved, int SW,
+                                int X0, int X1, int Y0, int Y1, uint32_t frame, const StepTask* task, const uint64_t* mats);
+extern "C" uint64_t worldStepTaskSSE(uint8_t* grid, uint8_t* moved, int SW,
+                                     int X0, int X1, int Y0, int Y1, uint32_t frame, const StepTask* task, const uint64_t* mats);
+extern "C" uint64_t worldStepTaskAVX(uint8_t* grid, uint8_t* moved, int SW,
+                                     int X0, int X1, int Y0, int Y1, uint32_t frame, const StepTask* task, const uint64_t* mats);
+extern "C" uint64_t worldStepTaskAVX512(uint8_t* grid, uint8_t* moved, int SW,
+                                        int X0, int X1, int Y0, int Y1, uint32_t frame, const StepTask* task, const uint64_t* mats);
+
+// The always-on neighbour-predicate reactions and the two cellular automata, vectorised
+// (simd_react.h): `rule` picks one, and `passes` is MARK_PASS and/or APPLY_PASS
+// (materials.h), as for the scalar reaction of the same name, whose marks and cells it
+// reproduces exactly.
+enum SimdReaction {
+    SR_IGNITE, SR_QUENCH, SR_GROW_PLANT, SR_DISSOLVE_ACID,
+    SR_MAKE_GLASS, SR_MELT_ICE, SR_FREEZE_WATER, SR_MUD_CYCLE,
+    SR_LIFE, SR_WIREWORLD,
+};
+using ReactStepFn = void (*)(int rule, uint8_t* grid, uint8_t* scratch, int SW,
+                             int X0, int X1, int Y0, int Y1, uint32_t frame, int passes);
+extern "C" void worldReactSSE(int rule, uint8_t* grid, uint8_t* scratch, int SW,
+                              int X0, int X1, int Y0, int Y1, uint32_t frame, int passes);
+extern "C" void worldReactAVX(int rule, uint8_t* grid, uint8_t* scratch, int SW,
+                              int X0, int X1, int Y0, int Y1, uint32_t frame, int passes);
+extern "C" void worldReactAVX512(int rule, uint8_t* grid, uint8_t* scratch, int SW,
+                                 int X0, int X1, int Y0, int Y1, uint32_t frame, int passes);
+
+enum SimdLevel { SIMD_SSE, SIMD_AVX2, SIMD_AVX512 };
+
+// SANDSIM_SIMD=sse|avx|avx512 forces a path (for testing); otherwise pick the widest
+// the running CPU supports (AVX-512BW -> 64 lanes, AVX2 -> 32, else SSE -> 16). All
+// compute the same result, so this is purely a performance / verification knob.
+inline SimdLevel simdLevel() {
     const char* e = std::getenv("SANDSIM_SIMD");
-    if (e && std::strcmp(e, "sse") == 0) return false;
-    if (e && std::strcmp(e, "avx") == 0) return true;
-    return __builtin_cpu_supports("avx2");
+    if (e && std::strcmp(e, "sse") == 0) return SIMD_SSE;
+    if (e && std::strcmp(e, "avx") == 0) return SIMD_AVX2;
+    if (e && std::strcmp(e, "avx512") == 0) return SIMD_AVX512;
+    if (__builtin_cpu_supports("avx512bw")) return SIMD_AVX512;
+    return __builtin_cpu_supports("avx2") ? SIMD_AVX2 : SIMD_SSE;
+}
+inline StepFn selectStep() {
+    switch (simdLevel()) {
+        case SIMD_AVX512: return worldStepAVX512;
+        case SIMD_AVX2:   return worldStepAVX;
+        default:          return worldStepSSE;
+    }
+}
+// SANDSIM_MOVE=fused runs the movement sub-passes fused over L2-sized row bands
+// instead of 16 full-grid sweeps. Same result; which is faster depends on whether the
+// live window already fits in L2 (see the MOVE lines of --bench).
+inline bool fusedMove() {
+    const char* e = std::getenv("SANDSIM_MOVE");
+    return e && std::strcmp(e, "fused") == 0;
+}
+inline StepFn selectFusedStep() {
+    switch (simdLevel()) {
+        case SIMD_AVX512: return worldStepFusedAVX512;
+        case SIMD_AVX2:   return worldStepFusedAVX;
+        default:          return worldStepFusedSSE;
+    }
+}
+// SANDSIM_MOVE=planes moves each rectangle on bitplanes instead (worldStepPlanes*).
+// Same result; kept selectable for windows where the movement dominates.
+inline bool planeMove() {
+    const char* e = std::getenv("SANDSIM_MOVE");
+    return e && std::strcmp(e, "planes") == 0;
+}
+inline StepFn selectPlaneStep() {
+    switch (simdLevel()) {
+        case SIMD_AVX512: return worldStepPlanesAVX512;
+        case SIMD_AVX2:   return worldStepPlanesAVX;
+        default:          return worldStepPlanesSSE;
+    }
+}
+inline BandStepFn selectBandStep() {
+    switch (simdLevel()) {
+        case SIMD_AVX512: return worldStepBandAVX512;
+        case SIMD_AVX2:   return worldStepBandAVX;
+        default:          return worldStepBandSSE;
+    }
+}
+inline TaskStepFn selectTaskStep() {
+    switch (simdLevel()) {
+        case SIMD_AVX512: return worldStepTaskAVX512;
+        case SIMD_AVX2:   return worldStepTaskAVX;
+        default:          return worldStepTaskSSE;
+    }
+}
+inline ReactStepFn selectReact() {
+    switch (simdLevel()) {
+        case SIMD_AVX512: return worldReactAVX512;
+        case SIMD_AVX2:   return worldReactAVX;
+        default:          return worldReactSSE;
+    }
+}
+inline int simdWidth() {
+    switch (simdLevel()) {
+        case SIMD_AVX512: return 64;
+        case SIMD_AVX2:   return 32;
+        default:          return 16;
+    }
+}
+inline const char* simdName() {
+    switch (simdLevel()) {
+        case SIMD_AVX512: return "avx512";
+        case SIMD_AVX2:   return "avx2";
+        default:          return "sse4.1";
+    }
 }
-inline StepFn selectStep() { return wantAVX() ? worldStepAVX : worldStepSSE; }
-inline const char* simdName() { return wantAVX() ? "avx2" : "sse4.1"; }
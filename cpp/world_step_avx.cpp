@@ -1,9 +1,37 @@
 // AVX2 step (32 lanes). Compiled with -mavx2. Only called when the CPU supports
 // AVX2 (see selectStep()), so its AVX2 instructions never run on an SSE-only CPU.
 #include "simd_core.h"
+#include "simd_react.h"
+#include "plane_step.h"
 #include "world_step.h"
 
-extern "C" void worldStepAVX(uint8_t* grid, uint8_t* moved, int SW,
-                             int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    simdStep<AvxOps>(grid, moved, SW, X0, X1, Y0, Y1, frame);
+extern "C" uint64_t worldStepAVX(uint8_t* grid, uint8_t* moved, int SW,
+                                 int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats) {
+    return simdStepFor<AvxOps>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame);
+}
+
+extern "C" uint64_t worldStepFusedAVX(uint8_t* grid, uint8_t* moved, int SW,
+                                      int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats) {
+    return simdStepFor<AvxOps>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame, fusedBandRows(SW));
+}
+
+extern "C" uint64_t worldStepPlanesAVX(uint8_t* grid, uint8_t* moved, int SW,
+                                       int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats) {
+    if ((X1 - X0) % 64) return simdStepFor<AvxOps>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame);
+    return planeStep<AvxOps>(grid, moved, SW, X0, X1, Y0, Y1, mats);
+}
+
+extern "C" uint64_t worldStepBandAVX(uint8_t* grid, uint8_t* moved, int SW,
+                                     int X0, int X1, int Y0, int Y1, uint32_t frame, const StepBand* band, const uint64_t* mats) {
+    return simdStepFor<AvxOps>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame, 0, band);
+}
+
+extern "C" uint64_t worldStepTaskAVX(uint8_t* grid, uint8_t* moved, int SW,
+                                     int X0, int X1, int Y0, int Y1, uint32_t frame, const StepTask* task, const uint64_t* mats) {
+    return simdStepFor<AvxOps>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame, 0, nullptr, task);
+}
+
+extern "C" void worldReactAVX(int rule, uint8_t* grid, uint8_t* scratch, int SW,
+                              int X0, int X1, int Y0, int Y1, uint32_t frame, int passes) {
+    simdReact<AvxOps>(rule, grid, scratch, SW, X0, X1, Y0, Y1, frame, passes);
 }
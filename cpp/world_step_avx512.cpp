@@ -0,0 +1,37 @@
+// AVX-512BW step (64 lanes, opmask blends). Compiled with -mavx512bw. Only called
+// when the CPU supports AVX-512BW (see selectStep()).
+#include "simd_core.h"
+#include "simd_react.h"
+#include "plane_step.h"
+#include "world_step.h"
+
+extern "C" uint64_t worldStepAVX512(uint8_t* grid, uint8_t* moved, int SW,
+                                    int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats) {
+    return simdStepFor<Avx512Ops>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame);
+}
+
+extern "C" uint64_t worldStepFusedAVX512(uint8_t* grid, uint8_t* moved, int SW,
+                                         int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats) {
+    return simdStepFor<Avx512Ops>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame, fusedBandRows(SW));
+}
+
+extern "C" uint64_t worldStepPlanesAVX512(uint8_t* grid, uint8_t* moved, int SW,
+                                          int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats) {
+    if ((X1 - X0) % 64) return simdStepFor<Avx512Ops>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame);
+    return planeStep<Avx512Ops>(grid, moved, SW, X0, X1, Y0, Y1, mats);
+}
+
+extern "C" uint64_t worldStepBandAVX512(uint8_t* grid, uint8_t* moved, int SW,
+                                        int X0, int X1, int Y0, int Y1, uint32_t frame, const StepBand* band, const uint64_t* mats) {
+    return simdStepFor<Avx512Ops>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame, 0, band);
+}
+
+extern "C" uint64_t worldStepTaskAVX512(uint8_t* grid, uint8_t* moved, int SW,
+                                        int X0, int X1, int Y0, int Y1, uint32_t frame, const StepTask* task, const uint64_t* mats) {
+    return simdStepFor<Avx512Ops>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame, 0, nullptr, task);
+}
+
+extern "C" void worldReactAVX512(int rule, uint8_t* grid, uint8_t* scratch, int SW,
+                                 int X0, int X1, int Y0, int Y1, uint32_t frame, int passes) {
+    simdReact<Avx512Ops>(rule, grid, scratch, SW, X0, X1, Y0, Y1, frame, passes);
+}
@@ -1,8 +1,36 @@
 // SSE4.1 step (16 lanes). Compiled with -msse4.1.
 #include "simd_core.h"
+#include "simd_react.h"
+#include "plane_step.h"
 #include "world_step.h"
 
-extern "C" void worldStepSSE(uint8_t* grid, uint8_t* moved, int SW,
-                             int X0, int X1, int Y0, int Y1, uint32_t frame) {
-    simdStep<SseOps>(grid, moved, SW, X0, X1, Y0, Y1, frame);
+extern "C" uint64_t worldStepSSE(uint8_t* grid, uint8_t* moved, int SW,
+                                 int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats) {
+    return simdStepFor<SseOps>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame);
+}
+
+extern "C" uint64_t worldStepFusedSSE(uint8_t* grid, uint8_t* moved, int SW,
+                                      int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats) {
+    return simdStepFor<SseOps>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame, fusedBandRows(SW));
+}
+
+extern "C" uint64_t worldStepPlanesSSE(uint8_t* grid, uint8_t* moved, int SW,
+                                       int X0, int X1, int Y0, int Y1, uint32_t frame, const uint64_t* mats) {
+    if ((X1 - X0) % 64) return simdStepFor<SseOps>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame);
+    return planeStep<SseOps>(grid, moved, SW, X0, X1, Y0, Y1, mats);
+}
+
+extern "C" uint64_t worldStepBandSSE(uint8_t* grid, uint8_t* moved, int SW,
+                                     int X0, int X1, int Y0, int Y1, uint32_t frame, const StepBand* band, const uint64_t* mats) {
+    return simdStepFor<SseOps>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame, 0, band);
+}
+
+extern "C" uint64_t worldStepTaskSSE(uint8_t* grid, uint8_t* moved, int SW,
+                                     int X0, int X1, int Y0, int Y1, uint32_t frame, const StepTask* task, const uint64_t* mats) {
+    return simdStepFor<SseOps>(mats, grid, moved, SW, X0, X1, Y0, Y1, frame, 0, nullptr, task);
+}
+
+extern "C" void worldReactSSE(int rule, uint8_t* grid, uint8_t* scratch, int SW,
+                              int X0, int X1, int Y0, int Y1, uint32_t frame, int passes) {
+    simdReact<SseOps>(rule, grid, scratch, SW, X0, X1, Y0, Y1, frame, passes);
 }
@@ -68,6 +68,7 @@ static ViewCfg parseView(int argc, char* argv[]) {
 }
 
 #include "../worldgen.h"   // shared deterministic seedMat() (diverse world, all backends)
+#include "../reaction_gates.h"   // shared per-pass reaction gates (all backends)
 #include "../hud_meta.h"   // material names, categorised palette layout, glow strengths
 #include "../hud.h"        // shared canvas (flicker+bloom) + HUD (palette/tooltip/bar)
 #include "../challenges.h" // challenge-mode mini-puzzles
@@ -139,110 +140,109 @@ void main() {
         }
         return;
     }
-    if (uType == 4) {                                     // ignite: oil (instant) / wood (slow) by fire/lava
-        int i = y * uSW + x;
-        bool hot = cells[i-1]==6u||cells[i-1]==7u || cells[i+1]==6u||cells[i+1]==7u ||
-                   cells[i-uSW]==6u||cells[i-uSW]==7u || cells[i+uSW]==6u||cells[i+uSW]==7u;
-        uint c = cells[i]; uint r = 0u;
-        if (c == 5u || c == 10u || c == 4u || c == 30u || c == 36u || c == 37u) r = hot ? 1u : 0u;  // oil, plant, gas, wisp, moss & fumes: instant
-        else if (c == 9u && hot) {                        // wood: smoulders
+    if (uType == 4) {                                     // igniteFire: mark (cpp/reaction_rules.h)
+        int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
+        bool n0 = cells[i-1]==6u||cells[i-1]==7u||cells[i+1]==6u||cells[i+1]==7u||cells[i-uSW]==6u||cells[i-uSW]==7u||cells[i+uSW]==6u||cells[i+uSW]==7u;
+        if (c==5u||c==10u||c==4u||c==30u||c==36u||c==37u) { if (n0) r = 1u; }
+        else if (c==9u) {
             uint h = (uint(x)*149u + uint(y)*83u + uint(uFrame)*157u) & 0xFFu;
-            r = (h < 28u) ? 1u : 0u;
+            if (n0 && h < 28u) r = 1u;
         }
         moved[i] = r;
         return;
     }
-    if (uType == 5) {                                     // ignite: apply marked cells -> fire
+    if (uType == 5) {                                     // igniteFire: apply (cpp/reaction_rules.h)
         int i = y * uSW + x;
-        if (moved[i] == 1u) cells[i] = 6u;
+        if (moved[i] != 0u) cells[i] = 6u;
         return;
     }
-    if (uType == 6) {                                     // water meets hot: mark interface cells
+    if (uType == 6) {                                     // quench: mark (cpp/reaction_rules.h)
         int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
-        bool nW  = cells[i-1]==3u||cells[i+1]==3u||cells[i-uSW]==3u||cells[i+uSW]==3u;
-        bool nFL = cells[i-1]==6u||cells[i-1]==7u||cells[i+1]==6u||cells[i+1]==7u||
-                   cells[i-uSW]==6u||cells[i-uSW]==7u||cells[i+uSW]==6u||cells[i+uSW]==7u;
-        if (c == 3u || c == 11u) r = nFL ? 1u : 0u;       // water / acid touching fire/lava
-        else if (c == 6u || c == 7u) r = nW ? 1u : 0u;    // fire/lava touching water
+        bool n0 = cells[i-1]==6u||cells[i-1]==7u||cells[i+1]==6u||cells[i+1]==7u||cells[i-uSW]==6u||cells[i-uSW]==7u||cells[i+uSW]==6u||cells[i+uSW]==7u;
+        bool n1 = cells[i-1]==3u||cells[i+1]==3u||cells[i-uSW]==3u||cells[i+uSW]==3u;
+        if (c==3u) { if (n0) r = 1u; }
+        else if (c==11u) { if (n0) r = 1u; }
+        else if (c==6u) { if (n1) r = 1u; }
+        else if (c==7u) { if (n1) r = 1u; }
         moved[i] = r;
         return;
     }
-    if (uType == 7) {                                     // apply: water->steam, acid->smoke, fire->empty, lava->obsidian
+    if (uType == 7) {                                     // quench: apply (cpp/reaction_rules.h)
         int i = y * uSW + x;
-        if (moved[i] == 1u) { uint c = cells[i]; cells[i] = (c==3u) ? 8u : (c==11u) ? 12u : (c==6u) ? 0u : 23u; }
+        if (moved[i] != 0u) { uint c = cells[i]; cells[i] = (c==3u) ? 8u : (c==11u) ? 12u : (c==6u) ? 0u : 23u; }
         return;
     }
-    if (uType == 8) {                                     // plant grow: mark empty next to plant+water
-        int i = y * uSW + x; uint r = 0u;
-        if (cells[i] == 0u) {
-            bool nP = cells[i-1]==10u||cells[i+1]==10u||cells[i-uSW]==10u||cells[i+uSW]==10u;
-            bool nW = cells[i-1]==3u||cells[i+1]==3u||cells[i-uSW]==3u||cells[i+uSW]==3u;
+    if (uType == 8) {                                     // growPlant: mark (cpp/reaction_rules.h)
+        int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
+        bool n0 = cells[i-1]==10u||cells[i+1]==10u||cells[i-uSW]==10u||cells[i+uSW]==10u;
+        bool n1 = cells[i-1]==3u||cells[i+1]==3u||cells[i-uSW]==3u||cells[i+uSW]==3u;
+        if (c==0u) {
             uint h = (uint(x)*113u + uint(y)*191u + uint(uFrame)*71u) & 0xFFu;
-            r = (nP && nW && h < 14u) ? 1u : 0u;
+            if (n0 && n1 && h < 14u) r = 1u;
         }
         moved[i] = r;
         return;
     }
-    if (uType == 9) {                                     // plant grow: apply -> plant
+    if (uType == 9) {                                     // growPlant: apply (cpp/reaction_rules.h)
         int i = y * uSW + x;
-        if (moved[i] == 1u) cells[i] = 10u;
+        if (moved[i] != 0u) cells[i] = 10u;
         return;
     }
-    if (uType == 10) {                                    // acid: mark dissolvable solid touching acid (11)
+    if (uType == 10) {                                    // dissolveAcid: mark (cpp/reaction_rules.h)
         int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
-        bool solid = (c==1u||c==2u||c==9u||c==10u);       // wall,sand,wood,plant
-        bool nA = cells[i-1]==11u||cells[i+1]==11u||cells[i-uSW]==11u||cells[i+uSW]==11u;
-        uint h = (uint(x)*53u + uint(y)*199u + uint(uFrame)*89u) & 0xFFu;
-        r = (solid && nA && h < 22u) ? 1u : 0u;
+        bool n0 = cells[i-1]==11u||cells[i+1]==11u||cells[i-uSW]==11u||cells[i+uSW]==11u;
+        if (c==1u||c==2u||c==9u||c==10u) {
+            uint h = (uint(x)*53u + uint(y)*199u + uint(uFrame)*89u) & 0xFFu;
+            if (n0 && h < 22u) r = 1u;
+        }
         moved[i] = r;
         return;
     }
-    if (uType == 11) {                                    // acid: apply -> dissolved (empty)
+    if (uType == 11) {                                    // dissolveAcid: apply (cpp/reaction_rules.h)
         int i = y * uSW + x;
-        if (moved[i] == 1u) cells[i] = 0u;
+        if (moved[i] != 0u) cells[i] = 0u;
         return;
     }
-    if (uType == 12) {                                    // glass: mark sand (2) touching lava (7)
-        int i = y * uSW + x; uint r = 0u;
-        if (cells[i] == 2u)
-            r = (cells[i-1]==7u||cells[i+1]==7u||cells[i-uSW]==7u||cells[i+uSW]==7u) ? 1u : 0u;
+    if (uType == 12) {                                    // makeGlass: mark (cpp/reaction_rules.h)
+        int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
+        bool n0 = cells[i-1]==7u||cells[i+1]==7u||cells[i-uSW]==7u||cells[i+uSW]==7u;
+        if (c==2u) { if (n0) r = 1u; }
         moved[i] = r;
         return;
     }
-    if (uType == 13) {                                    // glass: apply -> glass (13)
+    if (uType == 13) {                                    // makeGlass: apply (cpp/reaction_rules.h)
         int i = y * uSW + x;
-        if (moved[i] == 1u) cells[i] = 13u;
+        if (moved[i] != 0u) cells[i] = 13u;
         return;
     }
-    if (uType == 14) {                                    // ice/snow: mark ice(14)/snow(25) touching fire(6)/lava(7)
-        int i = y * uSW + x; uint r = 0u;
-        if (cells[i] == 14u || cells[i] == 25u) {
-            bool hot = cells[i-1]==6u||cells[i-1]==7u||cells[i+1]==6u||cells[i+1]==7u
-                     ||cells[i-uSW]==6u||cells[i-uSW]==7u||cells[i+uSW]==6u||cells[i+uSW]==7u;
+    if (uType == 14) {                                    // meltIce: mark (cpp/reaction_rules.h)
+        int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
+        bool n0 = cells[i-1]==6u||cells[i-1]==7u||cells[i+1]==6u||cells[i+1]==7u||cells[i-uSW]==6u||cells[i-uSW]==7u||cells[i+uSW]==6u||cells[i+uSW]==7u;
+        if (c==14u||c==25u) {
             uint h = (uint(x)*127u + uint(y)*163u + uint(uFrame)*41u) & 0xFFu;
-            r = (hot && h < 18u) ? 1u : 0u;
+            if (n0 && h < 18u) r = 1u;
         }
         moved[i] = r;
         return;
     }
-    if (uType == 15) {                                    // ice: apply -> water (3)
+    if (uType == 15) {                                    // meltIce: apply (cpp/reaction_rules.h)
         int i = y * uSW + x;
-        if (moved[i] == 1u) cells[i] = 3u;
+        if (moved[i] != 0u) cells[i] = 3u;
         return;
     }
-    if (uType == 16) {                                    // freeze: mark water (3) touching ice (14)
-        int i = y * uSW + x; uint r = 0u;
-        if (cells[i] == 3u) {
-            bool ice = cells[i-1]==14u||cells[i+1]==14u||cells[i-uSW]==14u||cells[i+uSW]==14u;
+    if (uType == 16) {                                    // freezeWater: mark (cpp/reaction_rules.h)
+        int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
+        bool n0 = cells[i-1]==14u||cells[i+1]==14u||cells[i-uSW]==14u||cells[i+uSW]==14u;
+        if (c==3u) {
             uint h = (uint(x)*181u + uint(y)*67u + uint(uFrame)*103u) & 0xFFu;
-            r = (ice && h < 4u) ? 1u : 0u;
+            if (n0 && h < 4u) r = 1u;
         }
         moved[i] = r;
         return;
     }
-    if (uType == 17) {                                    // freeze: apply -> ice (14)
+    if (uType == 17) {                                    // freezeWater: apply (cpp/reaction_rules.h)
         int i = y * uSW + x;
-        if (moved[i] == 1u) cells[i] = 14u;
+        if (moved[i] != 0u) cells[i] = 14u;
         return;
     }
     if (uType == 18) {                                    // spring: mark empty (0) touching spring (15)
@@ -308,22 +308,22 @@ void main() {
         if (moved[i] == 1u) cells[i] = 0u;
         return;
     }
-    if (uType == 26) {                                    // mud: mark sand->mud (1) by water, mud->sand (2) by hot
+    if (uType == 26) {                                    // mudCycle: mark (cpp/reaction_rules.h)
         int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
-        if (c == 2u) {
-            bool w = cells[i-1]==3u||cells[i+1]==3u||cells[i-uSW]==3u||cells[i+uSW]==3u;
+        bool n0 = cells[i-1]==3u||cells[i+1]==3u||cells[i-uSW]==3u||cells[i+uSW]==3u;
+        bool n1 = cells[i-1]==6u||cells[i-1]==7u||cells[i+1]==6u||cells[i+1]==7u||cells[i-uSW]==6u||cells[i-uSW]==7u||cells[i+uSW]==6u||cells[i+uSW]==7u;
+        if (c==2u) {
             uint h = (uint(x)*157u + uint(y)*97u + uint(uFrame)*61u) & 0xFFu;
-            if (w && h < 10u) r = 1u;
-        } else if (c == 20u) {
-            bool hot = cells[i-1]==6u||cells[i-1]==7u||cells[i+1]==6u||cells[i+1]==7u
-                     ||cells[i-uSW]==6u||cells[i-uSW]==7u||cells[i+uSW]==6u||cells[i+uSW]==7u;
+            if (n0 && h < 10u) r = 1u;
+        }
+        else if (c==20u) {
             uint h = (uint(x)*83u + uint(y)*173u + uint(uFrame)*109u) & 0xFFu;
-            if (hot && h < 14u) r = 2u;
+            if (n1 && h < 14u) r = 2u;
         }
         moved[i] = r;
         return;
     }
-    if (uType == 27) {                                    // mud: apply (1 -> mud 20, 2 -> sand 2)
+    if (uType == 27) {                                    // mudCycle: apply (cpp/reaction_rules.h)
         int i = y * uSW + x; uint m = moved[i];
         if (m == 1u) cells[i] = 20u; else if (m == 2u) cells[i] = 2u;
         return;
@@ -1281,51 +1281,9 @@ private:
     // trigger material is absent (a guaranteed no-op). Set, never cleared; safe (a stale flag
     // only costs an extra no-op dispatch). Mirrors the CPU build's gate. See passEnabled().
     bool present[MATERIAL_COUNT] = {false};
-    // A gated reaction's two pass types run only while its trigger material(s) can be present.
-    bool passEnabled(int t) const {
-        switch (t) {
-            case 18: case 19: return present[SPRING];
-            case 20: case 21: return present[TNT] || present[GUNPOWDER] || present[NITRO];
-            case 22: case 23: return present[VOLCANO];
-            case 24: case 25: return present[VOID];
-            case 28: case 29: return present[VIRUS];
-            case 30: case 31: return present[SPARK];
-            case 32: case 33: return present[SALT] || present[LYE] || present[CHLORINE];  // LYE/CHLORINE make SALT
-            case 34: case 35: return present[MERCURY];
-            case 36: case 37: return present[THERMITE];
-            case 38: case 39: return present[FROST];
-            case 40: case 41: return present[COAL] || present[EMBER];
-            case 42: case 43: return present[CLONER];
-            case 44: case 45: return present[CRYSTAL];
-            case 46: case 47: return present[ANTIMATTER];
-            case 48: case 49: return present[MOSS];
-            case 50: case 51: return present[EHEAD] || present[ETAIL] || present[SENSOR] || present[BATTERY];  // sensor/battery can create electrons
-            case 54: case 55: return present[SENSOR];
-            case 56: case 57: return present[LIFE];
-            case 58: case 59: return present[GEYSER];
-            case 60: case 61: return present[LYE];
-            case 62: case 63: return present[SODIUM];
-            case 64: case 65: return present[CORAL];
-            case 66: case 67: return present[PHOSPHORUS];
-            case 68: case 69: return present[CEMENT];
-            case 70: case 71: return present[CHLORINE];
-            case 72: case 73: return present[BATTERY];
-            case 74: case 75: return present[FUSE] || present[BURNFUSE];
-            case 76: case 77: return present[CRYO];
-            case 78: case 79: return present[LAMP] || present[LAMPLIT];
-            case 80: case 81: return present[PETRIFY];
-            case 82: case 83: return present[FIREWORK];
-            case 84: case 85: return present[SPROUT] || present[SEED];
-            case 86: case 87: return present[BELT];
-            case 88: case 89: return present[MAGNET];
-            case 90: case 91: return present[IRON] || present[RUST];
-            case 92: case 93: return present[SEED];
-            case 94: case 95: return present[LASER] || present[BEAM];
-            case 96: case 97: return present[ICICLE];
-            case 52: case 53: return present[IGNITER];
-            default: return true;   // 3-17, 26-27: always-on core reactions
-        }
-    }
+    // A gated reaction's two pass types run only while its trigger material(s) can be present
+    // (the gate table all three builds share, reaction_gates.h).
+    bool passEnabled(int t) const { return reactionPassEnabled(t, present); }
     GLint lSW, lX0, lX1, lY0, lY1, lType, lDx, lDy, lPar, lGrp, lFrame;
 
     void syncDown() {
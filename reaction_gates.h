@@ -0,0 +1,72 @@
+// Shared reaction gates -- which material must be resident for a paint-only reaction
+// to do anything, by the reaction's pass types. The C++ SIMD, OpenGL and Vulkan builds
+// all dispatch the same numbered passes (type 3 is the per-cell decay, then each
+// reaction is a mark/apply pair of types 2i+2 and 2i+3); this table is the one place
+// their gates are written down. A gated pair runs only while one of its `gate`
+// materials is (or, on the GPU, has been) resident -- a guaranteed no-op otherwise --
+// and every pass type not listed is one of the always-on core reactions (3-17, 26-27).
+// A new gated reaction adds its row here and every backend picks it up. Like
+// worldgen.h, each backend defines the Material enum before including this header.
+#pragma once
+#include <cstdint>
+
+struct ReactionGate {
+    int type;            // the mark pass; `type + 1` is its apply
+    uint8_t gate[4];     // trigger materials, padded with EMPTY (never a trigger)
+};
+static constexpr ReactionGate kReactionGates[] = {
+    {18, {SPRING}},
+    {20, {TNT, GUNPOWDER, NITRO}},
+    {22, {VOLCANO}},
+    {24, {VOID}},
+    {28, {VIRUS}},
+    {30, {SPARK}},
+    {32, {SALT, LYE, CHLORINE}},                 // LYE/CHLORINE make SALT
+    {34, {MERCURY}},
+    {36, {THERMITE}},
+    {38, {FROST}},
+    {40, {COAL, EMBER}},
+    {42, {CLONER}},
+    {44, {CRYSTAL}},
+    {46, {ANTIMATTER}},
+    {48, {MOSS}},
+    {50, {EHEAD, ETAIL, SENSOR, BATTERY}},       // sensor/battery can create electrons
+    {52, {IGNITER}},
+    {54, {SENSOR}},
+    {56, {LIFE}},
+    {58, {GEYSER}},
+    {60, {LYE}},
+    {62, {SODIUM}},
+    {64, {CORAL}},
+    {66, {PHOSPHORUS}},
+    {68, {CEMENT}},
+    {70, {CHLORINE}},
+    {72, {BATTERY}},
+    {74, {FUSE, BURNFUSE}},
+    {76, {CRYO}},
+    {78, {LAMP, LAMPLIT}},
+    {80, {PETRIFY}},
+    {82, {FIREWORK}},
+    {84, {SPROUT, SEED}},                        // SEED germinates into SPROUT
+    {86, {BELT}},
+    {88, {MAGNET}},
+    {90, {IRON, RUST}},
+    {92, {SEED}},
+    {94, {LASER, BEAM}},
+    {96, {ICICLE}},
+};
+
+// The gate row of pass `type` (mark or apply), or nullptr for an always-on pass.
+constexpr const ReactionGate* reactionGate(int type) {
+    for (const ReactionGate& g : kReactionGates)
+        if (type == g.type || type == g.type + 1) return &g;
+    return nullptr;
+}
+// Whether pass `type` can do anything with the materials flagged in present[].
+inline bool reactionPassEnabled(int type, const bool* present) {
+    const ReactionGate* g = reactionGate(type);
+    if (!g) return true;
+    for (uint8_t m : g->gate)
+        if (m != EMPTY && present[m]) return true;
+    return false;
+}
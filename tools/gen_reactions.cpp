@@ -0,0 +1,21 @@
+// Prints the GPU mark/apply passes of the neighbour reactions of cpp/reaction_rules.h,
+// for the Vulkan shader (`vk`, pc.* push constants) or the OpenGL one (`gl`, u*
+// uniforms). After changing the table, regenerate the goldens and paste the blocks
+// over the ones of the same pass types in vulkan/shaders/world.comp and
+// opengl/sandsim_world_gl.cpp:
+//
+//   g++ -std=c++17 gen_reactions.cpp -o gen_reactions
+//   ./gen_reactions vk > golden/reactions.vk.glsl
+//   ./gen_reactions gl > golden/reactions.gl.glsl
+#include "reaction_glsl.h"
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char** argv) {
+    if (argc != 2 || (strcmp(argv[1], "vk") && strcmp(argv[1], "gl"))) {
+        fprintf(stderr, "usage: %s vk|gl\n", argv[0]);
+        return 2;
+    }
+    fputs(reactionGlsl(!strcmp(argv[1], "vk")).c_str(), stdout);
+    return 0;
+}
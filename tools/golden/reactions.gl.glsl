@@ -0,0 +1,125 @@
+    if (uType == 4) {                                     // igniteFire: mark (cpp/reaction_rules.h)
+        int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
+        bool n0 = cells[i-1]==6u||cells[i-1]==7u||cells[i+1]==6u||cells[i+1]==7u||cells[i-uSW]==6u||cells[i-uSW]==7u||cells[i+uSW]==6u||cells[i+uSW]==7u;
+        if (c==5u||c==10u||c==4u||c==30u||c==36u||c==37u) { if (n0) r = 1u; }
+        else if (c==9u) {
+            uint h = (uint(x)*149u + uint(y)*83u + uint(uFrame)*157u) & 0xFFu;
+            if (n0 && h < 28u) r = 1u;
+        }
+        moved[i] = r;
+        return;
+    }
+    if (uType == 5) {                                     // igniteFire: apply (cpp/reaction_rules.h)
+        int i = y * uSW + x;
+        if (moved[i] != 0u) cells[i] = 6u;
+        return;
+    }
+    if (uType == 6) {                                     // quench: mark (cpp/reaction_rules.h)
+        int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
+        bool n0 = cells[i-1]==6u||cells[i-1]==7u||cells[i+1]==6u||cells[i+1]==7u||cells[i-uSW]==6u||cells[i-uSW]==7u||cells[i+uSW]==6u||cells[i+uSW]==7u;
+        bool n1 = cells[i-1]==3u||cells[i+1]==3u||cells[i-uSW]==3u||cells[i+uSW]==3u;
+        if (c==3u) { if (n0) r = 1u; }
+        else if (c==11u) { if (n0) r = 1u; }
+        else if (c==6u) { if (n1) r = 1u; }
+        else if (c==7u) { if (n1) r = 1u; }
+        moved[i] = r;
+        return;
+    }
+    if (uType == 7) {                                     // quench: apply (cpp/reaction_rules.h)
+        int i = y * uSW + x;
+        if (moved[i] != 0u) { uint c = cells[i]; cells[i] = (c==3u) ? 8u : (c==11u) ? 12u : (c==6u) ? 0u : 23u; }
+        return;
+    }
+    if (uType == 8) {                                     // growPlant: mark (cpp/reaction_rules.h)
+        int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
+        bool n0 = cells[i-1]==10u||cells[i+1]==10u||cells[i-uSW]==10u||cells[i+uSW]==10u;
+        bool n1 = cells[i-1]==3u||cells[i+1]==3u||cells[i-uSW]==3u||cells[i+uSW]==3u;
+        if (c==0u) {
+            uint h = (uint(x)*113u + uint(y)*191u + uint(uFrame)*71u) & 0xFFu;
+            if (n0 && n1 && h < 14u) r = 1u;
+        }
+        moved[i] = r;
+        return;
+    }
+    if (uType == 9) {                                     // growPlant: apply (cpp/reaction_rules.h)
+        int i = y * uSW + x;
+        if (moved[i] != 0u) cells[i] = 10u;
+        return;
+    }
+    if (uType == 10) {                                    // dissolveAcid: mark (cpp/reaction_rules.h)
+        int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
+        bool n0 = cells[i-1]==11u||cells[i+1]==11u||cells[i-uSW]==11u||cells[i+uSW]==11u;
+        if (c==1u||c==2u||c==9u||c==10u) {
+            uint h = (uint(x)*53u + uint(y)*199u + uint(uFrame)*89u) & 0xFFu;
+            if (n0 && h < 22u) r = 1u;
+        }
+        moved[i] = r;
+        return;
+    }
+    if (uType == 11) {                                    // dissolveAcid: apply (cpp/reaction_rules.h)
+        int i = y * uSW + x;
+        if (moved[i] != 0u) cells[i] = 0u;
+        return;
+    }
+    if (uType == 12) {                                    // makeGlass: mark (cpp/reaction_rules.h)
+        int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
+        bool n0 = cells[i-1]==7u||cells[i+1]==7u||cells[i-uSW]==7u||cells[i+uSW]==7u;
+        if (c==2u) { if (n0) r = 1u; }
+        moved[i] = r;
+        return;
+    }
+    if (uType == 13) {                                    // makeGlass: apply (cpp/reaction_rules.h)
+        int i = y * uSW + x;
+        if (moved[i] != 0u) cells[i] = 13u;
+        return;
+    }
+    if (uType == 14) {                                    // meltIce: mark (cpp/reaction_rules.h)
+        int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
+        bool n0 = cells[i-1]==6u||cells[i-1]==7u||cells[i+1]==6u||cells[i+1]==7u||cells[i-uSW]==6u||cells[i-uSW]==7u||cells[i+uSW]==6u||cells[i+uSW]==7u;
+        if (c==14u||c==25u) {
+            uint h = (uint(x)*127u + uint(y)*163u + uint(uFrame)*41u) & 0xFFu;
+            if (n0 && h < 18u) r = 1u;
+        }
+        moved[i] = r;
+        return;
+    }
+    if (uType == 15) {                                    // meltIce: apply (cpp/reaction_rules.h)
+        int i = y * uSW + x;
+        if (moved[i] != 0u) cells[i] = 3u;
+        return;
+    }
+    if (uType == 16) {                                    // freezeWater: mark (cpp/reaction_rules.h)
+        int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
+        bool n0 = cells[i-1]==14u||cells[i+1]==14u||cells[i-uSW]==14u||cells[i+uSW]==14u;
+        if (c==3u) {
+            uint h = (uint(x)*181u + uint(y)*67u + uint(uFrame)*103u) & 0xFFu;
+            if (n0 && h < 4u) r = 1u;
+        }
+        moved[i] = r;
+        return;
+    }
+    if (uType == 17) {                                    // freezeWater: apply (cpp/reaction_rules.h)
+        int i = y * uSW + x;
+        if (moved[i] != 0u) cells[i] = 14u;
+        return;
+    }
+    if (uType == 26) {                                    // mudCycle: mark (cpp/reaction_rules.h)
+        int i = y * uSW + x; uint c = cells[i]; uint r = 0u;
+        bool n0 = cells[i-1]==3u||cells[i+1]==3u||cells[i-uSW]==3u||cells[i+uSW]==3u;
+        bool n1 = cells[i-1]==6u||cells[i-1]==7u||cells[i+1]==6u||cells[i+1]==7u||cells[i-uSW]==6u||cells[i-uSW]==7u||cells[i+uSW]==6u||cells[i+uSW]==7u;
+        if (c==2u) {
+            uint h = (uint(x)*157u + uint(y)*97u + uint(uFrame)*61u) & 0xFFu;
+            if (n0 && h < 10u) r = 1u;
+        }
+        else if (c==20u) {
+            uint h = (uint(x)*83u + uint(y)*173u + uint(uFrame)*109u) & 0xFFu;
+            if (n1 && h < 14u) r = 2u;
+        }
+        moved[i] = r;
+        return;
+    }
+    if (uType == 27) {                                    // mudCycle: apply (cpp/reaction_rules.h)
+        int i = y * uSW + x; uint m = moved[i];
+        if (m == 1u) cells[i] = 20u; else if (m == 2u) cells[i] = 2u;
+        return;
+    }
@@ -0,0 +1,114 @@
+// The GPU passes of the neighbour reactions, written out from kReactionRules
+// (cpp/reaction_rules.h): for each row its mark block (`type`) and apply block
+// (`type + 1`) in the form of the hand-written blocks of vulkan/shaders/world.comp and
+// the OpenGL compute shader -- `vulkan` picks the push-constant names (pc.type, pc.SW,
+// pc.frame) over the uniforms (uType, uSW, uFrame). The output is checked in under
+// tools/golden/ and checked against it, and against materials.h, by
+// test_reaction_rules.cpp; gen_reactions.cpp prints it.
+#pragma once
+#include "../cpp/reaction_rules.h"
+#include <algorithm>
+#include <string>
+
+namespace reaction_glsl {
+
+inline std::string u(int v) { return std::to_string(v) + "u"; }
+
+// `c==5u||c==10u`, for the materials of l.
+inline std::string isAny(const MatList& l, const std::string& c) {
+    std::string s;
+    for (int j = 0; j < l.n; ++j) s += (j ? "||" : "") + c + "==" + u(l.id[j]);
+    return s;
+}
+// Whether one of the 4 neighbours of cell i is one of l.
+inline std::string nearAny(const MatList& l, const std::string& SW) {
+    const std::string at[4] = {"cells[i-1]", "cells[i+1]", "cells[i-" + SW + "]", "cells[i+" + SW + "]"};
+    std::string s;
+    for (int k = 0; k < 4; ++k) s += (k ? "||" : "") + isAny(l, at[k]);
+    return s;
+}
+inline bool sameList(const MatList& a, const MatList& b) {
+    if (a.n != b.n) return false;
+    for (int j = 0; j < a.n; ++j)
+        if (a.id[j] != b.id[j]) return false;
+    return true;
+}
+// `    if (pc.type == 4) {` and its comment, at the shaders' comment column.
+inline std::string opens(const std::string& T, int type, const std::string& note) {
+    std::string s = "    if (" + T + " == " + std::to_string(type) + ") {";
+    s.resize(std::max<size_t>(s.size() + 1, 58), ' ');
+    return s + "// " + note + "\n";
+}
+
+// The mark: one bool per distinct neighbour list, then the clauses as an if/else chain
+// on the cell (their `self` lists are disjoint).
+inline std::string markBlock(const ReactionRule& r, const std::string& T, const std::string& SW, const std::string& F) {
+    std::string s = opens(T, r.type, std::string(r.name) + ": mark (cpp/reaction_rules.h)");
+    s += "        int i = y * " + SW + " + x; uint c = cells[i]; uint r = 0u;\n";
+    const MatList* lists[8];
+    int nl = 0;
+    auto nbName = [&](const MatList& l) {
+        for (int k = 0; k < nl; ++k)
+            if (sameList(*lists[k], l)) return "n" + std::to_string(k);
+        lists[nl] = &l;
+        s += "        bool n" + std::to_string(nl) + " = " + nearAny(l, SW) + ";\n";
+        return "n" + std::to_string(nl++);
+    };
+    std::string chain;
+    for (int k = 0; k < clauseCount(r); ++k) {
+        const RuleClause& c = r.clause[k];
+        std::string cond = nbName(c.near);
+        if (c.near2.n) cond += " && " + nbName(c.near2);
+        chain += std::string(k ? "        else if (" : "        if (") + isAny(c.self, "c") + ") {";
+        if (c.hash.below) {
+            chain += "\n            uint h = (uint(x)*" + u(c.hash.ax) + " + uint(y)*" + u(c.hash.ay) + " + uint(" + F + ")*" +
+                     u(c.hash.af) + ") & 0xFFu;\n";
+            chain += "            if (" + cond + " && h < " + u(c.hash.below) + ") r = " + u(c.mark) + ";\n        }\n";
+        } else {
+            chain += " if (" + cond + ") r = " + u(c.mark) + "; }\n";
+        }
+    }
+    return s + chain + "        moved[i] = r;\n        return;\n    }\n";
+}
+
+// What a cell c marked m becomes: `into` by its own material, the last clause's the default.
+inline std::string product(const ReactionRule& r, int m) {
+    const int last = lastWithMark(r, m);
+    std::string s;
+    for (int k = 0; k < last; ++k)
+        if (r.clause[k].mark == m && r.clause[k].into != r.clause[last].into)
+            s += "(" + isAny(r.clause[k].self, "c") + ") ? " + u(r.clause[k].into) + " : ";
+    return s + u(r.clause[last].into);
+}
+inline bool byMaterial(const ReactionRule& r, int m) { return product(r, m).find('?') != std::string::npos; }
+
+inline std::string applyBlock(const ReactionRule& r, const std::string& T, const std::string& SW) {
+    std::string s = opens(T, r.type + 1, std::string(r.name) + ": apply (cpp/reaction_rules.h)");
+    auto set = [&](int m) {
+        return byMaterial(r, m) ? "{ uint c = cells[i]; cells[i] = " + product(r, m) + "; }" : "cells[i] = " + product(r, m) + ";";
+    };
+    if (marksOne(r)) {
+        s += "        int i = y * " + SW + " + x;\n";
+        s += "        if (moved[i] != 0u) " + set(1) + "\n";
+    } else {
+        s += "        int i = y * " + SW + " + x; uint m = moved[i];\n        ";
+        for (int k = 0; k < clauseCount(r); ++k) {
+            const int m = r.clause[k].mark;
+            if (firstWithMark(r, m) != k) continue;
+            s += std::string(k ? " else if" : "if") + " (m == " + u(m) + ") " + set(m);
+        }
+        s += "\n";
+    }
+    return s + "        return;\n    }\n";
+}
+
+}  // namespace reaction_glsl
+
+// Every row's mark and apply blocks, in table order.
+inline std::string reactionGlsl(bool vulkan) {
+    using namespace reaction_glsl;
+    const std::string T = vulkan ? "pc.type" : "uType", SW = vulkan ? "pc.SW" : "uSW", F = vulkan ? "pc.frame" : "uFrame";
+    std::string s;
+    for (const ReactionRule& r : kReactionRules) s += markBlock(r, T, SW, F) + applyBlock(r, T, SW);
+    return s;
+}
@@ -0,0 +1,167 @@
+// Unit test for the reaction tables the backends share: kReactionGates
+// (reaction_gates.h) gates the same passes the OpenGL build's old hand-written switch
+// did, and the GPU passes generated from kReactionRules (cpp/reaction_rules.h) are
+// the golden files, are what both shaders contain, and -- compiled here as C++ -- mark
+// and rewrite random grids exactly as the scalar rules of materials.h do.
+//
+// Run from tools/: g++ -std=c++17 -O2 test_reaction_rules.cpp -o test_reaction_rules
+#include "../cpp/materials.h"
+#include "../reaction_gates.h"
+#include "reaction_glsl.h"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+// The OpenGL build's gate before reaction_gates.h, as it was written there.
+static bool oldPassEnabled(int t, const bool* present) {
+    switch (t) {
+        case 18: case 19: return present[SPRING];
+        case 20: case 21: return present[TNT] || present[GUNPOWDER] || present[NITRO];
+        case 22: case 23: return present[VOLCANO];
+        case 24: case 25: return present[VOID];
+        case 28: case 29: return present[VIRUS];
+        case 30: case 31: return present[SPARK];
+        case 32: case 33: return present[SALT] || present[LYE] || present[CHLORINE];
+        case 34: case 35: return present[MERCURY];
+        case 36: case 37: return present[THERMITE];
+        case 38: case 39: return present[FROST];
+        case 40: case 41: return present[COAL] || present[EMBER];
+        case 42: case 43: return present[CLONER];
+        case 44: case 45: return present[CRYSTAL];
+        case 46: case 47: return present[ANTIMATTER];
+        case 48: case 49: return present[MOSS];
+        case 50: case 51: return present[EHEAD] || present[ETAIL] || present[SENSOR] || present[BATTERY];
+        case 54: case 55: return present[SENSOR];
+        case 56: case 57: return present[LIFE];
+        case 58: case 59: return present[GEYSER];
+        case 60: case 61: return present[LYE];
+        case 62: case 63: return present[SODIUM];
+        case 64: case 65: return present[CORAL];
+        case 66: case 67: return present[PHOSPHORUS];
+        case 68: case 69: return present[CEMENT];
+        case 70: case 71: return present[CHLORINE];
+        case 72: case 73: return present[BATTERY];
+        case 74: case 75: return present[FUSE] || present[BURNFUSE];
+        case 76: case 77: return present[CRYO];
+        case 78: case 79: return present[LAMP] || present[LAMPLIT];
+        case 80: case 81: return present[PETRIFY];
+        case 82: case 83: return present[FIREWORK];
+        case 84: case 85: return present[SPROUT] || present[SEED];
+        case 86: case 87: return present[BELT];
+        case 88: case 89: return present[MAGNET];
+        case 90: case 91: return present[IRON] || present[RUST];
+        case 92: case 93: return present[SEED];
+        case 94: case 95: return present[LASER] || present[BEAM];
+        case 96: case 97: return present[ICICLE];
+        case 52: case 53: return present[IGNITER];
+        default: return true;
+    }
+}
+
+// The Vulkan golden as C++: the shader's buffers and push constants, and its blocks
+// as the body of one invocation.
+namespace glsl {
+typedef uint32_t uint;
+static struct { int SW, type, frame; } pc;
+static std::vector<uint> cells, moved;
+static void invoke(int x, int y) {
+#include "golden/reactions.vk.glsl"
+}
+}  // namespace glsl
+
+static const int SWr = 48, SHr = 14;
+
+static void scalarRule(int type, uint8_t* g, uint8_t* s, uint32_t f, int passes) {
+    const int X0 = 1, X1 = SWr - 1, Y0 = 1, Y1 = SHr - 1;
+    switch (type) {
+        case 4:  igniteFire(g, s, SWr, X0, X1, Y0, Y1, f, passes); break;
+        case 6:  quench(g, s, SWr, X0, X1, Y0, Y1, passes); break;
+        case 8:  growPlant(g, s, SWr, X0, X1, Y0, Y1, f, passes); break;
+        case 10: dissolveAcid(g, s, SWr, X0, X1, Y0, Y1, f, passes); break;
+        case 12: makeGlass(g, s, SWr, X0, X1, Y0, Y1, passes); break;
+        case 14: meltIce(g, s, SWr, X0, X1, Y0, Y1, f, passes); break;
+        case 16: freezeWater(g, s, SWr, X0, X1, Y0, Y1, f, passes); break;
+        case 26: mudCycle(g, s, SWr, X0, X1, Y0, Y1, f, passes); break;
+    }
+}
+static void glslPass(int type, uint32_t f) {
+    glsl::pc = {SWr, type, (int)f};
+    for (int y = 1; y < SHr - 1; ++y)
+        for (int x = 1; x < SWr - 1; ++x) glsl::invoke(x, y);
+}
+
+// Mostly the materials the rules test for, so that every clause fires; the rest any id.
+static const uint8_t kMix[] = {EMPTY, FIRE, LAVA, WATER, ACID, ICE, SNOW, PLANT, OIL, WOOD, GAS, WISP,
+                               MOSS, FUMES, SAND, MUD, WALL, STEAM};
+
+static std::string readFile(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+int main() {
+    int fails = 0;
+    std::mt19937 rng(4242);
+
+    // 1. The shared gate table against the switch it replaced, over random residency.
+    {
+        bool ok = true;
+        bool present[MATERIAL_COUNT];
+        for (int it = 0; it < 20000 && ok; ++it) {
+            const unsigned density = 1 + rng() % 32;
+            for (bool& p : present) p = rng() % density == 0;
+            for (int t = 0; t < 100 && ok; ++t)
+                if (reactionPassEnabled(t, present) != oldPassEnabled(t, present)) {
+                    printf("FAIL: pass %d gated differently from the old switch\n", t);
+                    ok = false;
+                }
+        }
+        if (ok) printf("ok: kReactionGates gates every pass like the old switch\n"); else ++fails;
+    }
+
+    // 2. The generator's output is the checked-in golden, and each shader holds it.
+    const std::string here = __FILE__, dir = here.find('/') == std::string::npos ? "." : here.substr(0, here.rfind('/'));
+    const struct { bool vulkan; const char* golden; const char* shader; } outs[] = {
+        {true, "/golden/reactions.vk.glsl", "/../vulkan/shaders/world.comp"},
+        {false, "/golden/reactions.gl.glsl", "/../opengl/sandsim_world_gl.cpp"}};
+    for (const auto& o : outs) {
+        const std::string gen = reactionGlsl(o.vulkan), golden = readFile(dir + o.golden), shader = readFile(dir + o.shader);
+        if (gen != golden) { printf("FAIL: tools%s is stale: regenerate it with gen_reactions\n", o.golden); ++fails; continue; }
+        bool inShader = true;
+        for (size_t a = 0, b; a < gen.size(); a = b) {   // block by block: they sit in two runs
+            b = gen.find("    if (", a + 1);
+            if (b == std::string::npos) b = gen.size();
+            if (shader.find(gen.substr(a, b - a)) == std::string::npos) inShader = false;
+        }
+        if (!inShader) { printf("FAIL: %s does not hold the generated passes of tools%s\n", o.shader + 4, o.golden); ++fails; }
+        else printf("ok: %s is the generator's output and %s holds it\n", o.golden + 1, o.shader + 4);
+    }
+
+    // 3. The generated passes, run as C++, against materials.h: marks, then cells.
+    const int before = fails;
+    for (const ReactionRule& r : kReactionRules) {
+        bool ok = true;
+        for (int it = 0; it < 300 && ok; ++it) {
+            std::vector<uint8_t> g((size_t)SWr * SHr), s(g.size(), 0);
+            for (auto& v : g) v = rng() % 4 ? kMix[rng() % sizeof kMix] : (uint8_t)(rng() % MATERIAL_COUNT);
+            const uint32_t f = rng() & 0x7FFFFFFF;
+            glsl::cells.assign(g.begin(), g.end());
+            glsl::moved.assign(g.size(), 0);
+            scalarRule(r.type, g.data(), s.data(), f, MARK_PASS);
+            glslPass(r.type, f);
+            for (size_t i = 0; i < g.size(); ++i) ok = ok && glsl::moved[i] == s[i];
+            scalarRule(r.type, g.data(), s.data(), f, APPLY_PASS);
+            glslPass(r.type + 1, f);
+            for (size_t i = 0; i < g.size(); ++i) ok = ok && glsl::cells[i] == g[i];
+        }
+        if (!ok) { printf("FAIL: the generated %s passes differ from materials.h\n", r.name); ++fails; }
+    }
+    if (fails == before) printf("ok: the generated passes match materials.h\n");
+
+    printf(fails ? "\n%d FAILED\n" : "\nALL PASSED\n", fails);
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,219 @@
+// Differential test of the frame's shortcuts on hand-built scenes: each scene is
+// stepped with sleeping chunks (dirty rects, wakeRects()/restoreSleeping()/settle()),
+// parked chunks (parkChunks()/track()) and site lists (gatherSites()/runSites()), on
+// one thread and on three, and with the site lists alone, and every run must end
+// bit-identical to the plain full-window step (SANDSIM_SLEEP=off, SANDSIM_SITES=off)
+// -- and the shortcut must actually have been taken: some chunk-frames slept, or, in
+// the periodic scenes, were parked, and the site passes ran on their sites.
+//
+// Builds against the host translation unit (for SimdWorld), so it needs SDL's headers
+// like the binary: g++ -std=c++17 -O2 -pthread test_scenes.cpp ../cpp/world_step_*.o
+#define SANDSIM_NO_MAIN
+#include "../cpp/sandsim_world.cpp"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static const int GW = 8, GH = 4;  // the window and world, in chunks
+static const int W = GW * CHUNK, H = GH * CHUNK;
+using Scene = std::vector<uint8_t>;
+
+static uint32_t cellHash(int x, int y) {
+    uint32_t h = (uint32_t)(x * 7919 + y * 104729);
+    h ^= h >> 16; h *= 0x7feb352d; h ^= h >> 15; h *= 0x846ca68b; h ^= h >> 16;
+    return h;
+}
+static void fill(Scene& s, int x0, int y0, int x1, int y1, uint8_t m) {
+    for (int y = y0; y < y1; ++y)
+        for (int x = x0; x < x1; ++x) s[(size_t)y * W + x] = m;
+}
+
+// Two sand heaps dropped onto a wall floor: they fall and settle, and the empty sky
+// above them has nothing to do.
+static Scene settlingSand() {
+    Scene s((size_t)W * H, EMPTY);
+    fill(s, 0, 240, W, H, WALL);
+    for (int y = 20; y < 90; ++y)
+        for (int x = 30; x < 110; ++x) if (cellHash(x, y) % 3) s[(size_t)y * W + x] = SAND;
+    for (int y = 100; y < 130; ++y)
+        for (int x = 300; x < 340; ++x) if (cellHash(x, y) % 2) s[(size_t)y * W + x] = SAND;
+    return s;
+}
+// A spring dripping into a walled basin, a volcano on the floor far from it and a
+// geyser shut in a chamber between them.
+static Scene emitters() {
+    Scene s((size_t)W * H, EMPTY);
+    fill(s, 0, 240, W, H, WALL);
+    fill(s, 10, 120, 12, 200, WALL);
+    fill(s, 70, 120, 72, 200, WALL);
+    fill(s, 10, 200, 72, 202, WALL);
+    s[(size_t)60 * W + 40] = SPRING;
+    s[(size_t)239 * W + 450] = VOLCANO;
+    fill(s, 240, 200, 262, 202, WALL);
+    fill(s, 240, 202, 242, 240, WALL);
+    fill(s, 260, 202, 262, 240, WALL);
+    s[(size_t)239 * W + 250] = GEYSER;
+    return s;
+}
+
+// Life blinkers, one across a chunk edge, next to a still block.
+static Scene lifeBlinkers() {
+    Scene s((size_t)W * H, EMPTY);
+    for (int k = 0; k < 6; ++k) fill(s, 40 + 70 * k, 50 + 25 * k, 43 + 70 * k, 51 + 25 * k, LIFE);
+    fill(s, 127, 150, 128, 153, LIFE);
+    fill(s, 300, 200, 302, 202, LIFE);
+    return s;
+}
+// Wireworld clocks: an electron circling a 3x3 loop of wire (period 8), in every other
+// chunk, and a sand heap settling in the corner away from them.
+static Scene wireClocks() {
+    Scene s((size_t)W * H, EMPTY);
+    fill(s, 0, 240, W, H, WALL);
+    for (int cy = 0; cy < 3; ++cy)
+        for (int cx = 0; cx < GW; ++cx) {
+            if ((cx + cy) % 2 || (cx < 2 && cy == 2)) continue;
+            const int x = cx * CHUNK + 30, y = cy * CHUNK + 30;
+            fill(s, x, y, x + 3, y + 3, WIRE);
+            s[(size_t)(y + 1) * W + x + 1] = EMPTY;
+            s[(size_t)y * W + x] = EHEAD;
+            s[(size_t)y * W + x + 1] = ETAIL;
+        }
+    for (int y = 150; y < 200; ++y)
+        for (int x = 10; x < 60; ++x) if (cellHash(x, y) % 3 == 0) s[(size_t)y * W + x] = SAND;
+    return s;
+}
+
+// Wave fronts: a virus eating into a plant bed, frost spreading through a pool, a lit
+// fuse burning to a TNT charge, nitro flowing along a cup to the lava at its far end
+// (a site that moves several cells a frame) with thermite dropping in after it, and
+// TNT across a chunk edge touching lava. The charges are small: a solid block of
+// sites sweeps instead.
+static Scene waveFronts() {
+    Scene s((size_t)W * H, EMPTY);
+    fill(s, 0, 240, W, H, WALL);
+    for (int x = 0; x < W; x += 40) fill(s, x, 200, x + 20, 240, PLANT);
+    for (int x = 20; x < W; x += 40) fill(s, x, 200, x + 20, 240, WATER);
+    s[(size_t)201 * W + 100] = VIRUS;
+    s[(size_t)205 * W + 30] = FROST;
+    fill(s, 10, 150, 200, 151, FUSE);
+    s[(size_t)150 * W + 200] = TNT;
+    s[(size_t)149 * W + 10] = FIRE;
+    fill(s, 370, 196, 412, 198, WALL);
+    fill(s, 370, 186, 372, 196, WALL);
+    fill(s, 410, 186, 412, 196, WALL);
+    fill(s, 404, 194, 410, 196, LAVA);
+    fill(s, 374, 170, 377, 172, NITRO);
+    fill(s, 380, 120, 384, 124, THERMITE);
+    fill(s, 64, 60, 68, 62, TNT);
+    fill(s, 126, 60, 130, 62, TNT);
+    s[(size_t)59 * W + 65] = LAVA;
+    return s;
+}
+// Wire circuits: a battery driving a long wire that ends at an igniter under some
+// wood and at a lamp, and big loops each carrying one electron, one with sand
+// falling onto it.
+static Scene wireCircuits() {
+    Scene s((size_t)W * H, EMPTY);
+    fill(s, 0, 240, W, H, WALL);
+    s[(size_t)30 * W + 100] = BATTERY;
+    fill(s, 101, 30, 400, 31, WIRE);
+    fill(s, 400, 30, 401, 60, WIRE);
+    s[(size_t)60 * W + 400] = IGNITER;
+    fill(s, 396, 62, 405, 66, WOOD);
+    s[(size_t)30 * W + 401] = LAMP;
+    for (int k = 0; k < 3; ++k) {
+        const int x0 = 20 + 160 * k, y0 = 100, x1 = x0 + 120, y1 = 220;
+        fill(s, x0, y0, x1, y0 + 1, WIRE);
+        fill(s, x0, y1 - 1, x1, y1, WIRE);
+        fill(s, x0, y0, x0 + 1, y1, WIRE);
+        fill(s, x1 - 1, y0, x1, y1, WIRE);
+        s[(size_t)y0 * W + x0 + 10] = EHEAD;
+        s[(size_t)y0 * W + x0 + 9] = ETAIL;
+    }
+    for (int y = 40; y < 60; ++y)
+        for (int x = 60; x < 80; ++x) if (cellHash(x, y) % 4 == 0) s[(size_t)y * W + x] = SAND;
+    return s;
+}
+
+// The shortcuts a scene must take: sleeping chunks, parked chunks, site lists.
+enum Expect { SLEEPS = 1, PARKS = 2, SITES = 4 };
+struct SceneCase { const char* name; Scene (*build)(); int expect; };
+static const SceneCase kScenes[] = {
+    {"settling sand", settlingSand, SLEEPS},
+    {"emitters", emitters, SLEEPS | SITES},
+    {"life blinkers", lifeBlinkers, PARKS},
+    {"wire clocks", wireClocks, PARKS | SITES},
+    {"wave fronts", waveFronts, SITES},
+    {"wire circuits", wireCircuits, SITES},
+};
+
+struct Run { uint64_t checksum; double awake, parked, sites; };
+
+// 300 frames of the scene; `sleep` and `sites` off are SANDSIM_SLEEP=off and
+// SANDSIM_SITES=off.
+static Run runScene(const Scene& scene, int threads, bool sleep, bool sites) {
+    g_threads = threads;
+    if (!sleep) setenv("SANDSIM_SLEEP", "off", 1);
+    if (!sites) setenv("SANDSIM_SITES", "off", 1);
+    const std::string dir = "/tmp/sandsim_test_scenes";
+    std::filesystem::remove_all(dir);
+    Run r;
+    {
+        SimdWorld world(GW, GH, GW, GH, dir);
+        world.generateAllToDisk();
+        world.setWindow(0, 0);
+        world.loadView(scene.data(), W, H, 0, 0);
+        for (int f = 0; f < 300; ++f) world.step();
+        uint64_t cnt[MATERIAL_COUNT];
+        world.summary(r.checksum, cnt);
+        r.awake = world.awakeShare();
+        r.parked = world.parkedShare();
+        r.sites = world.siteShare();
+    }
+    std::filesystem::remove_all(dir);
+    unsetenv("SANDSIM_SLEEP");
+    unsetenv("SANDSIM_SITES");
+    return r;
+}
+
+int main() {
+    int fails = 0;
+    selectKernels();
+    const struct { int threads; bool sleep, sites; const char* name; } variants[] = {
+        {1, false, true, "site lists"}, {1, true, true, "all shortcuts"}, {3, true, true, "all shortcuts"}};
+    for (const SceneCase& sc : kScenes) {
+        const Scene scene = sc.build();
+        const Run plain = runScene(scene, 1, false, false);
+        bool ok = true;
+        double awake = 1.0, parked = 0.0, sites = 0.0;
+        for (const auto& v : variants) {
+            const Run r = runScene(scene, v.threads, v.sleep, v.sites);
+            if (r.checksum != plain.checksum) {
+                printf("FAIL: %s, %s on %d thread(s): %016llx, full step %016llx\n", sc.name, v.name, v.threads,
+                       (unsigned long long)r.checksum, (unsigned long long)plain.checksum);
+                ok = false;
+            }
+            if (v.sleep) awake = std::min(awake, r.awake);
+            parked = std::max(parked, r.parked);
+            sites = std::max(sites, r.sites);
+        }
+        if (ok && (sc.expect & SLEEPS) && awake >= 0.9) {
+            printf("FAIL: %s: %.1f%% of chunk-frames awake, nothing slept\n", sc.name, 100.0 * awake);
+            ok = false;
+        }
+        if (ok && (sc.expect & PARKS) && parked < 0.1) {
+            printf("FAIL: %s: %.1f%% of chunk-frames parked\n", sc.name, 100.0 * parked);
+            ok = false;
+        }
+        if (ok && (sc.expect & SITES) && sites < 0.5) {
+            printf("FAIL: %s: %.1f%% of site passes ran on their sites\n", sc.name, 100.0 * sites);
+            ok = false;
+        }
+        if (ok)
+            printf("ok: %s matches the full step (%016llx): %.1f%% awake, %.1f%% parked, %.1f%% of site passes on sites\n",
+                   sc.name, (unsigned long long)plain.checksum, 100.0 * awake, 100.0 * parked, 100.0 * sites);
+        else ++fails;
+    }
+    printf(fails ? "\n%d FAILED\n" : "\nALL PASSED\n", fails);
+    return fails ? 1 : 0;
+}
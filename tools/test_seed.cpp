@@ -47,7 +47,7 @@ int main() {
     std::vector<uint8_t> gg, mv;
     auto restRow = [&](uint8_t mat) {
         gg.assign(W*H, EMPTY); gg[(size_t)5*W+40] = mat;
-        for (int it=0; it<H+8; ++it) { mv.assign(W*H,0); worldStepSSE(gg.data(), mv.data(), W, 1, W-1, 1, H-1, 0); }
+        for (int it=0; it<H+8; ++it) { mv.assign(W*H,0); worldStepSSE(gg.data(), mv.data(), W, 1, W-1, 1, H-1, 0, nullptr); }
         int yy=-1; for(int y=0;y<H;++y) for(int x=0;x<W;++x) if(gg[(size_t)y*W+x]==mat) yy=y; return yy;
     };
     int se = restRow(SEED), sa = restRow(SAND);
@@ -0,0 +1,110 @@
+// Unit test for the vectorised reactions (simd_react.h): every worldReact* rule, on
+// every ISA the CPU runs, marks and rewrites random grids exactly as the scalar rule of
+// materials.h does -- rectangles of any width, so the partial block at the right edge
+// and the scalar tail are covered. Then one whole-world check that the threaded frame (task graph, row and tile layouts) ends
+// bit-identical to one thread.
+//
+// Builds against the host translation unit (for SimdWorld), so it needs SDL's headers
+// like the binary: g++ -std=c++17 -O2 -pthread test_simd_react.cpp ../cpp/world_step_*.o
+#define SANDSIM_NO_MAIN
+#include "../cpp/sandsim_world.cpp"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static const int SWr = 256, SHr = 16;
+
+static void scalarReact(int rule, uint8_t* g, uint8_t* s, int X0, int X1, int Y0, int Y1, uint32_t f, int passes) {
+    switch (rule) {
+        case SR_IGNITE:        igniteFire(g, s, SWr, X0, X1, Y0, Y1, f, passes); break;
+        case SR_QUENCH:        quench(g, s, SWr, X0, X1, Y0, Y1, passes); break;
+        case SR_GROW_PLANT:    growPlant(g, s, SWr, X0, X1, Y0, Y1, f, passes); break;
+        case SR_DISSOLVE_ACID: dissolveAcid(g, s, SWr, X0, X1, Y0, Y1, f, passes); break;
+        case SR_MAKE_GLASS:    makeGlass(g, s, SWr, X0, X1, Y0, Y1, passes); break;
+        case SR_MELT_ICE:      meltIce(g, s, SWr, X0, X1, Y0, Y1, f, passes); break;
+        case SR_FREEZE_WATER:  freezeWater(g, s, SWr, X0, X1, Y0, Y1, f, passes); break;
+        case SR_MUD_CYCLE:     mudCycle(g, s, SWr, X0, X1, Y0, Y1, f, passes); break;
+        case SR_LIFE:          conwayLife(g, s, SWr, X0, X1, Y0, Y1, passes); break;
+        case SR_WIREWORLD:     wireWorld(g, s, SWr, X0, X1, Y0, Y1, passes); break;
+    }
+}
+static const char* kRuleNames[] = {"ignite", "quench", "growPlant", "dissolveAcid", "makeGlass",
+                                   "meltIce", "freezeWater", "mudCycle", "life", "wireworld"};
+
+// Mostly the materials the rules test for, so that every branch fires; the rest any id.
+static const uint8_t kMix[] = {EMPTY, FIRE, LAVA, WATER, ACID, ICE, PLANT, OIL, WOOD, GAS, SAND, MUD,
+                               STEAM, SMOKE, WALL, LIFE, LIFE, LIFE, WIRE, WIRE, EHEAD, ETAIL};
+
+// One random grid and rectangle through `fn` and the scalar rule: marks, then cells.
+static bool checkOnce(ReactStepFn fn, int rule, std::mt19937& rng) {
+    std::vector<uint8_t> g((size_t)SWr * SHr), s(g.size());
+    for (auto& v : g) v = rng() % 4 ? kMix[rng() % sizeof kMix] : (uint8_t)(rng() % MATERIAL_COUNT);
+    for (auto& v : s) v = (uint8_t)rng();
+    const int X0 = 2 + (int)(rng() % 70), X1 = X0 + 1 + (int)(rng() % (SWr - 4 - X0));
+    const int Y0 = 2 + (int)(rng() % 4), Y1 = Y0 + 1 + (int)(rng() % (SHr - 4 - Y0));
+    const uint32_t f = rng();
+    std::vector<uint8_t> g2 = g, s2 = s;
+    fn(rule, g.data(), s.data(), SWr, X0, X1, Y0, Y1, f, MARK_PASS);
+    scalarReact(rule, g2.data(), s2.data(), X0, X1, Y0, Y1, f, MARK_PASS);
+    if (s != s2) return false;
+    fn(rule, g.data(), s.data(), SWr, X0, X1, Y0, Y1, f, APPLY_PASS);
+    scalarReact(rule, g2.data(), s2.data(), X0, X1, Y0, Y1, f, APPLY_PASS);
+    return g == g2;
+}
+
+// The streaming bench's walk over a 4x4-chunk world with a 3x3 window, as a checksum.
+static uint64_t worldChecksum(int threads, GridLayout layout) {
+    g_threads = threads;
+    const std::string dir = "/tmp/sandsim_test_simd_react";
+    std::filesystem::remove_all(dir);
+    uint64_t ck, cnt[MATERIAL_COUNT];
+    {
+        SimdWorld world(3, 3, 4, 4, dir, layout);
+        world.generateAllToDisk();
+        const int steps = 120;
+        for (int s = 0; s < steps; ++s) {
+            const int visit = s * 4 / steps;
+            world.setWindow(visit & 1, visit >> 1);
+            world.step();
+        }
+        world.summary(ck, cnt);
+    }
+    std::filesystem::remove_all(dir);
+    return ck;
+}
+
+int main() {
+    int fails = 0;
+    std::mt19937 rng(12345);
+
+    // 1. Each rule, each ISA, 200 random rectangles.
+    struct Isa { const char* name; ReactStepFn fn; bool ok; };
+    const Isa isas[] = {{"sse", worldReactSSE, true},
+                        {"avx2", worldReactAVX, (bool)__builtin_cpu_supports("avx2")},
+                        {"avx512", worldReactAVX512, (bool)__builtin_cpu_supports("avx512bw")}};
+    for (const Isa& isa : isas) {
+        if (!isa.ok) { printf("skip: %s not supported by this CPU\n", isa.name); continue; }
+        const int before = fails;
+        for (int rule = SR_IGNITE; rule <= SR_WIREWORLD; ++rule) {
+            bool ok = true;
+            for (int it = 0; it < 200 && ok; ++it) ok = checkOnce(isa.fn, rule, rng);
+            if (!ok) { printf("FAIL: %s %s differs from the scalar rule\n", isa.name, kRuleNames[rule]); ++fails; }
+        }
+        if (fails == before) printf("ok: %s reactions match materials.h\n", isa.name);
+    }
+
+    // 2. Threads: the task graph on the row grid and on tiles, against one thread.
+    selectKernels();
+    const uint64_t one = worldChecksum(1, GridLayout::Rows);
+    const struct { int threads; GridLayout layout; const char* name; } runs[] = {
+        {3, GridLayout::Rows, "3 threads, rows"}, {2, GridLayout::Tiles, "2 threads, tiles"},
+        {3, GridLayout::Tiles, "3 threads, tiles"}};
+    for (const auto& r : runs) {
+        const uint64_t ck = worldChecksum(r.threads, r.layout);
+        if (ck != one) { printf("FAIL: %s checksum %016llx, one thread %016llx\n", r.name, (unsigned long long)ck, (unsigned long long)one); ++fails; }
+        else printf("ok: %s matches one thread (%016llx)\n", r.name, (unsigned long long)one);
+    }
+
+    printf(fails ? "\n%d FAILED\n" : "\nALL PASSED\n", fails);
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,54 @@
+// Unit test for temporal tiles (SimdWorld::stepAhead, SANDSIM_TEMPORAL): a window too
+// large for one copy -- so it is cut into cores with halos, more than one per step --
+// stepped K frames per step() call ends bit-identical to the same world stepped one
+// frame per call, for several K, on one thread and on three.
+//
+// Builds against the host translation unit (for SimdWorld), so it needs SDL's headers
+// like the binary: g++ -std=c++17 -O2 -pthread test_temporal.cpp ../cpp/world_step_*.o
+#define SANDSIM_NO_MAIN
+#include "../cpp/sandsim_world.cpp"
+#include <cstdio>
+#include <cstdlib>
+
+// A 16x16-chunk window (2.2 MB of grid, scratch and moved, past AHEAD_TILE_BYTES)
+// stepped `frames` frames `frames` at a time, as a checksum; `tiles` is how many
+// copies stepAhead() built.
+static uint64_t checksum(int frames, int threads, unsigned long long& tiles) {
+    g_threads = threads;
+    const std::string dir = "/tmp/sandsim_test_temporal";
+    std::filesystem::remove_all(dir);
+    uint64_t ck, cnt[MATERIAL_COUNT];
+    {
+        SimdWorld world(16, 16, 16, 16, dir);
+        world.generateAllToDisk();
+        world.setWindow(0, 0);
+        for (int s = 0; s < 36; s += frames) world.step(frames);
+        world.summary(ck, cnt);
+        tiles = world.temporalTiles();
+    }
+    std::filesystem::remove_all(dir);
+    return ck;
+}
+
+int main() {
+    int fails = 0;
+    selectKernels();
+    unsigned long long tiles;
+    const uint64_t serial = checksum(1, 1, tiles);
+    const struct { int frames, threads; } runs[] = {{2, 1}, {3, 1}, {4, 1}, {3, 3}};
+    for (const auto& r : runs) {
+        const uint64_t ck = checksum(r.frames, r.threads, tiles);
+        const unsigned long long calls = (36 + r.frames - 1) / r.frames;
+        if (tiles <= calls) {
+            printf("FAIL: %d frames per step built %llu copies in %llu steps: the window was not tiled\n", r.frames, tiles, calls);
+            ++fails;
+        } else if (ck != serial) {
+            printf("FAIL: %d frames per step on %d thread(s): %016llx, one frame per step %016llx\n", r.frames, r.threads,
+                   (unsigned long long)ck, (unsigned long long)serial);
+            ++fails;
+        } else printf("ok: %d frames per step on %d thread(s), %llu copies, matches one frame per step (%016llx)\n", r.frames,
+                      r.threads, tiles, (unsigned long long)serial);
+    }
+    printf(fails ? "\n%d FAILED\n" : "\nALL PASSED\n", fails);
+    return fails ? 1 : 0;
+}
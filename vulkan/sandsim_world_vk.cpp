@@ -65,6 +65,7 @@ static ViewCfg parseView(int argc, char* argv[]) {
 }
 
 #include "../worldgen.h"   // shared deterministic seedMat() (diverse world, all backends)
+#include "../reaction_gates.h"   // shared per-pass reaction gates (all backends)
 #include "../hud_meta.h"   // material names, categorised palette layout, glow strengths
 #include "../hud.h"        // shared canvas (flicker+bloom) + HUD (palette/tooltip/bar)
 #include "../challenges.h" // challenge-mode mini-puzzles
@@ -287,53 +288,11 @@ private:
     uint32_t frame = 0;
     bool hasReactive = false;        // gates the reaction dispatches (any reactive material)
     // Per-material "ever resident" latch -> skip the dispatch for a paint-only reaction whose
-    // trigger material is absent (a guaranteed no-op). Set, never cleared. Mirrors the CPU/GL
-    // build's gate exactly (same pass numbering), so all three stay bit-identical.
+    // trigger material is absent (a guaranteed no-op). Set, never cleared. The gates are the
+    // table the CPU/GL builds use too (reaction_gates.h, same pass numbering), so all three
+    // stay bit-identical.
     bool seen[MATERIAL_COUNT] = {false};
-    bool passEnabled(int t) const {
-        switch (t) {
-            case 18: case 19: return seen[SPRING];
-            case 20: case 21: return seen[TNT] || seen[GUNPOWDER] || seen[NITRO];
-            case 22: case 23: return seen[VOLCANO];
-            case 24: case 25: return seen[VOID];
-            case 28: case 29: return seen[VIRUS];
-            case 30: case 31: return seen[SPARK];
-            case 32: case 33: return seen[SALT] || seen[LYE] || seen[CHLORINE];  // LYE/CHLORINE make SALT
-            case 34: case 35: return seen[MERCURY];
-            case 36: case 37: return seen[THERMITE];
-            case 38: case 39: return seen[FROST];
-            case 40: case 41: return seen[COAL] || seen[EMBER];
-            case 42: case 43: return seen[CLONER];
-            case 44: case 45: return seen[CRYSTAL];
-            case 46: case 47: return seen[ANTIMATTER];
-            case 48: case 49: return seen[MOSS];
-            case 50: case 51: return seen[EHEAD] || seen[ETAIL] || seen[SENSOR] || seen[BATTERY];  // sensor/battery can create electrons
-            case 54: case 55: return seen[SENSOR];
-            case 56: case 57: return seen[LIFE];
-            case 58: case 59: return seen[GEYSER];
-            case 60: case 61: return seen[LYE];
-            case 62: case 63: return seen[SODIUM];
-            case 64: case 65: return seen[CORAL];
-            case 66: case 67: return seen[PHOSPHORUS];
-            case 68: case 69: return seen[CEMENT];
-            case 70: case 71: return seen[CHLORINE];
-            case 72: case 73: return seen[BATTERY];
-            case 74: case 75: return seen[FUSE] || seen[BURNFUSE];
-            case 76: case 77: return seen[CRYO];
-            case 78: case 79: return seen[LAMP] || seen[LAMPLIT];
-            case 80: case 81: return seen[PETRIFY];
-            case 82: case 83: return seen[FIREWORK];
-            case 84: case 85: return seen[SPROUT] || seen[SEED];
-            case 86: case 87: return seen[BELT];
-            case 88: case 89: return seen[MAGNET];
-            case 90: case 91: return seen[IRON] || seen[RUST];
-            case 92: case 93: return seen[SEED];
-            case 94: case 95: return seen[LASER] || seen[BEAM];
-            case 96: case 97: return seen[ICICLE];
-            case 52: case 53: return seen[IGNITER];
-            default: return true;   // 3-17, 26-27: always-on core reactions
-        }
-    }
+    bool passEnabled(int t) const { return reactionPassEnabled(t, seen); }
 
     VkInstance instance = VK_NULL_HANDLE;
     VkPhysicalDevice phys = VK_NULL_HANDLE;